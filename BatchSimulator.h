@@ -0,0 +1,422 @@
+#ifndef BATCHSIMULATOR_H
+#define BATCHSIMULATOR_H
+
+#include "Deck.h"
+#include "GameEngine.h"
+#include "Random.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Plays many greedy-bot games in lockstep, one game per lane.
+ *
+ * The per-turn state of all lanes is kept as structure of arrays (hand
+ * masks per seat, top card, current seat, direction, turn count) and each
+ * step runs every lane through the same three phases:
+ *
+ *   1. playability kernel: hand mask of the current seat AND the rule row
+ *      of the top card, the greedy lead (lowest playable kind) and its
+ *      stack mask, for 8 lanes per AVX-512 instruction (4 with AVX2 for
+ *      the masks; plain loop otherwise);
+ *   2. per lane: the cards leave the hand and the deck is drawn from;
+ *   3. effects kernel: Skip / Reverse / Draw Two and the end-of-turn
+ *      advance as branch-free blends, 8 lanes per AVX2 instruction.
+ *
+ * Finished lanes are refilled with the next game from the queue. Each
+ * lane keeps its own Deck, and every draw, discard and shuffle happens in
+ * the same order as in BasicGameEngine with GreedyPolicy in every seat,
+ * so game i gives exactly the result the scalar engine gives for the same
+ * seed.
+ *
+ * @tparam LANES Games in flight, a multiple of 8 (8, 16 or 32).
+ * @author Tuan
+ */
+template <int LANES = 16>
+class BatchSimulator {
+    static_assert(LANES % 8 == 0, "LANES must be a multiple of 8");
+
+public:
+    static constexpr int MAX_PLAYERS = GameState::MAX_PLAYERS;
+    static constexpr int NO_PLAY = -1;
+
+private:
+    typedef GameEngine Engine;   // standard rules only
+
+    // --- Per-turn state, lane index last ---
+    alignas(64) uint64_t hands[MAX_PLAYERS][LANES];     // kinds held per seat
+    alignas(64) int32_t handSize[MAX_PLAYERS][LANES];
+    alignas(64) int32_t seat[LANES];
+    alignas(64) int32_t top[LANES];
+    alignas(64) int32_t forward[LANES];                 // 1 forward, 0 backward
+    alignas(64) int32_t turns[LANES];
+    alignas(64) int32_t live[LANES];                    // lane is playing a game
+    alignas(64) int32_t over[LANES];                    // game ended this step
+
+    // --- Kernel outputs ---
+    alignas(64) uint64_t playable[LANES];
+    alignas(64) uint64_t stack[LANES];
+    alignas(64) int32_t lead[LANES];
+    alignas(64) int32_t effect[LANES];                  // CardType played, or NO_PLAY
+    alignas(64) int32_t effectCount[LANES];
+    alignas(64) int32_t victim[LANES];
+
+    // --- Per-lane state touched one lane at a time ---
+    uint8_t counts[LANES][MAX_PLAYERS][Card::NUM_KINDS];
+    Deck decks[LANES];
+    uint64_t gameOf[LANES];
+    int32_t winner[LANES];
+
+    int players;
+    int maxTurns;
+
+    void addCard(int l, int s, int kind) {
+        counts[l][s][kind]++;
+        hands[s][l] |= 1ULL << kind;
+        handSize[s][l]++;
+    }
+
+    void removeAll(int l, int s, int kind) {
+        handSize[s][l] -= counts[l][s][kind];
+        counts[l][s][kind] = 0;
+        hands[s][l] &= ~(1ULL << kind);
+    }
+
+    void removeOne(int l, int s, int kind) {
+        handSize[s][l]--;
+        if (--counts[l][s][kind] == 0) hands[s][l] &= ~(1ULL << kind);
+    }
+
+    /** Same steps as BasicGameEngine::start() with greedy policies. */
+    void startGame(int l, uint64_t game, uint64_t seed) {
+        Deck& deck = decks[l];
+        deck.seed(seed);
+        std::memset(counts[l], 0, sizeof(counts[l]));
+        for (int s = 0; s < MAX_PLAYERS; s++) {
+            hands[s][l] = 0;
+            handSize[s][l] = 0;
+        }
+        seat[l] = 0;
+        forward[l] = 1;
+        turns[l] = 0;
+        live[l] = 1;
+        winner[l] = -1;
+        gameOf[l] = game;
+
+        deck.build();
+        deck.shuffle();
+        for (int s = 0; s < players; s++) {
+            for (int j = 0; j < Engine::INITIAL_HAND_SIZE; j++) {
+                if (!deck.isEmpty()) addCard(l, s, deck.drawFromDeck().kind());
+            }
+        }
+        Card first = deck.drawFromDeck();
+        while (first.type() != NUMBER) {
+            deck.addCard(first);
+            deck.shuffle();
+            first = deck.drawFromDeck();
+        }
+        top[l] = first.kind();
+    }
+
+    // --- Phase 1: playability kernel ---
+
+    void playabilityKernel() {
+#if defined(__AVX512F__) && defined(__AVX512CD__)
+        const uint64_t* handBase = &hands[0][0];
+        const __m512i zero = _mm512_setzero_si512();
+        const __m256i laneStep = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        for (int base = 0; base < LANES; base += 8) {
+            __m256i seats = _mm256_load_si256(reinterpret_cast<const __m256i*>(seat + base));
+            __m256i lanes = _mm256_add_epi32(laneStep, _mm256_set1_epi32(base));
+            __m256i slot = _mm256_add_epi32(_mm256_mullo_epi32(seats, _mm256_set1_epi32(LANES)), lanes);
+            __m512i hand = _mm512_mask_i32gather_epi64(zero, 0xFF, slot, handBase, 8);
+
+            __m256i tops = _mm256_load_si256(reinterpret_cast<const __m256i*>(top + base));
+            __m512i rule = _mm512_mask_i32gather_epi64(zero, 0xFF, tops, CARD_TABLES.playableOn, 8);
+            __m512i p = _mm512_and_si512(hand, rule);
+
+            // Lowest set bit: 63 - lzcnt(p & -p), -1 when nothing is playable
+            __m512i low = _mm512_and_si512(p, _mm512_sub_epi64(zero, p));
+            __m512i leads = _mm512_sub_epi64(_mm512_set1_epi64(63), _mm512_lzcnt_epi64(low));
+            __mmask8 any = _mm512_test_epi64_mask(p, p);
+            __m512i stacks = _mm512_mask_i64gather_epi64(zero, any, leads,
+                                                         CARD_TABLES.stackableWith, 8);
+
+            _mm512_store_si512(playable + base, p);
+            _mm512_store_si512(stack + base, _mm512_and_si512(stacks, hand));
+            _mm512_mask_cvtepi64_storeu_epi32(lead + base, 0xFF, leads);
+        }
+#else
+#if defined(__AVX2__)
+        const uint64_t* handBase = &hands[0][0];
+        const __m128i laneStep = _mm_setr_epi32(0, 1, 2, 3);
+        for (int base = 0; base < LANES; base += 4) {
+            __m128i seats = _mm_load_si128(reinterpret_cast<const __m128i*>(seat + base));
+            __m128i lanes = _mm_add_epi32(laneStep, _mm_set1_epi32(base));
+            __m128i slot = _mm_add_epi32(_mm_mullo_epi32(seats, _mm_set1_epi32(LANES)), lanes);
+            __m256i hand = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(handBase), slot, 8);
+            __m128i tops = _mm_load_si128(reinterpret_cast<const __m128i*>(top + base));
+            __m256i rule = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(CARD_TABLES.playableOn),
+                                                  tops, 8);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(playable + base), _mm256_and_si256(hand, rule));
+        }
+#else
+        for (int l = 0; l < LANES; l++) {
+            playable[l] = hands[seat[l]][l] & CARD_TABLES.playableOn[top[l]];
+        }
+#endif
+        for (int l = 0; l < LANES; l++) {
+            uint64_t p = playable[l];
+            int k = p ? __builtin_ctzll(p) : -1;
+            lead[l] = k;
+            stack[l] = p ? hands[seat[l]][l] & CARD_TABLES.stackableWith[k] : 0;
+        }
+#endif
+    }
+
+    // --- Phase 2: one lane's play or draw ---
+
+    void resolve(int l) {
+        int s = seat[l];
+        Deck& deck = decks[l];
+        effect[l] = NO_PLAY;
+        effectCount[l] = 0;
+
+        if (playable[l] != 0) {
+            // Greedy order: the lead, then every stacking kind ascending
+            // with all its copies (one copy of the lead's kind already used).
+            // All but the last card go to the discard pile after the old top.
+            int leadKind = lead[l];
+            deck.discard(Card::fromKind(top[l]));
+            int held = leadKind;
+            int played = 1;
+            uint64_t kinds = stack[l];
+            while (kinds) {
+                int k = __builtin_ctzll(kinds);
+                kinds &= kinds - 1;
+                int copies = counts[l][s][k] - (k == leadKind ? 1 : 0);
+                for (int c = 0; c < copies; c++) {
+                    deck.discard(Card::fromKind(held));
+                    held = k;
+                    played++;
+                }
+                removeAll(l, s, k);
+            }
+            top[l] = held;
+
+            if (handSize[s][l] == 0) {
+                winner[l] = s;
+                over[l] = 1;
+                return;
+            }
+            effect[l] = CARD_TABLES.type[leadKind];
+            effectCount[l] = played;
+            return;
+        }
+
+        if (deck.isEmpty()) return;
+        Card drawn = deck.drawFromDeck();
+        addCard(l, s, drawn.kind());
+        if (drawn.isPlayable(Card::fromKind(top[l]))) {
+            removeOne(l, s, drawn.kind());
+            deck.discard(Card::fromKind(top[l]));
+            top[l] = drawn.kind();
+            effect[l] = CARD_TABLES.type[drawn.kind()];
+            effectCount[l] = 1;
+        }
+    }
+
+    // --- Phase 3: effects kernel ---
+
+#if defined(__AVX2__)
+    /** Seat after one step in direction fwd (all-ones lanes move forward). */
+    static __m256i stepSeat(__m256i cur, __m256i fwd, __m256i n) {
+        const __m256i one = _mm256_set1_epi32(1);
+        __m256i up = _mm256_add_epi32(cur, one);
+        up = _mm256_andnot_si256(_mm256_cmpeq_epi32(up, n), up);
+        __m256i down = _mm256_sub_epi32(cur, one);
+        down = _mm256_blendv_epi8(down, _mm256_sub_epi32(n, one), _mm256_cmpeq_epi32(cur, _mm256_setzero_si256()));
+        return _mm256_blendv_epi8(down, up, fwd);
+    }
+#endif
+
+    void effectsKernel() {
+        const int32_t n = players;
+#if defined(__AVX2__)
+        const __m256i nv = _mm256_set1_epi32(n);
+        const __m256i nMinus1 = _mm256_set1_epi32(n - 1);
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i twoSeats = _mm256_set1_epi32(n == 2 ? -1 : 0);
+        for (int base = 0; base < LANES; base += 8) {
+            __m256i oldSeat = _mm256_load_si256(reinterpret_cast<const __m256i*>(seat + base));
+            __m256i oldFwd = _mm256_load_si256(reinterpret_cast<const __m256i*>(forward + base));
+            __m256i e = _mm256_load_si256(reinterpret_cast<const __m256i*>(effect + base));
+            __m256i c = _mm256_load_si256(reinterpret_cast<const __m256i*>(effectCount + base));
+            __m256i fwd = _mm256_cmpeq_epi32(oldFwd, one);
+
+            // Skip: move c % n seats (c <= 8 and n >= 2, see the loop below)
+            __m256i k = c;
+            for (int i = 0; i < 4; i++) {
+                k = _mm256_sub_epi32(k, _mm256_and_si256(_mm256_cmpgt_epi32(k, nMinus1), nv));
+            }
+            __m256i skipTo = _mm256_add_epi32(oldSeat, _mm256_blendv_epi8(_mm256_sub_epi32(nv, k), k, fwd));
+            skipTo = _mm256_sub_epi32(skipTo, _mm256_and_si256(_mm256_cmpgt_epi32(skipTo, nMinus1), nv));
+            __m256i cur = _mm256_blendv_epi8(oldSeat, skipTo, _mm256_cmpeq_epi32(e, _mm256_set1_epi32(SKIP)));
+
+            // Reverse: an odd stack flips direction
+            __m256i odd = _mm256_cmpeq_epi32(_mm256_and_si256(c, one), one);
+            __m256i flip = _mm256_and_si256(_mm256_cmpeq_epi32(e, _mm256_set1_epi32(REVERSE)), odd);
+            fwd = _mm256_xor_si256(fwd, flip);
+
+            // Draw Two (and Reverse with two seats): one extra step; that seat is the victim
+            __m256i extra = _mm256_or_si256(_mm256_cmpeq_epi32(e, _mm256_set1_epi32(DRAW_TWO)),
+                                            _mm256_and_si256(flip, twoSeats));
+            cur = _mm256_blendv_epi8(cur, stepSeat(cur, fwd, nv), extra);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(victim + base), cur);
+
+            // End of turn, unless the game is over or the lane is idle
+            __m256i overLanes = _mm256_load_si256(reinterpret_cast<const __m256i*>(over + base));
+            __m256i liveLanes = _mm256_load_si256(reinterpret_cast<const __m256i*>(live + base));
+            __m256i stays = _mm256_or_si256(_mm256_cmpeq_epi32(overLanes, one), _mm256_cmpeq_epi32(liveLanes, zero));
+            __m256i next = stepSeat(cur, fwd, nv);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(seat + base), _mm256_blendv_epi8(next, oldSeat, stays));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(forward + base),
+                               _mm256_blendv_epi8(_mm256_and_si256(fwd, one), oldFwd, stays));
+        }
+#else
+        for (int l = 0; l < LANES; l++) {
+            int32_t cur = seat[l];
+            int32_t fwd = forward[l];
+            int32_t e = effect[l];
+            int32_t c = effectCount[l];
+
+            // c % n: a stack holds at most 8 cards (two copies per color)
+            // and n >= 2, so four conditional subtractions are enough
+            int32_t k = c;
+            k = k >= n ? k - n : k;
+            k = k >= n ? k - n : k;
+            k = k >= n ? k - n : k;
+            k = k >= n ? k - n : k;
+            int32_t skipTo = cur + (fwd ? k : n - k);
+            skipTo = skipTo >= n ? skipTo - n : skipTo;
+            cur = (e == SKIP) ? skipTo : cur;
+
+            int32_t flip = (e == REVERSE) & (c & 1);
+            fwd ^= flip;
+
+            int32_t next = fwd ? (cur + 1 == n ? 0 : cur + 1) : (cur == 0 ? n - 1 : cur - 1);
+            int32_t extra = (e == DRAW_TWO) | (flip & (n == 2));
+            cur = extra ? next : cur;
+            victim[l] = cur;
+
+            next = fwd ? (cur + 1 == n ? 0 : cur + 1) : (cur == 0 ? n - 1 : cur - 1);
+            int32_t stays = over[l] | !live[l];
+            seat[l] = stays ? seat[l] : next;
+            forward[l] = stays ? forward[l] : fwd;
+        }
+#endif
+    }
+
+    void penaltyDraws(int l) {
+        Deck& deck = decks[l];
+        int total = Engine::DRAW_TWO_PENALTY * effectCount[l];
+        for (int i = 0; i < total; i++) {
+            if (!deck.isEmpty()) addCard(l, victim[l], deck.drawFromDeck().kind());
+        }
+    }
+
+public:
+    explicit BatchSimulator(int players, int maxTurns = Engine::DEFAULT_MAX_TURNS)
+        : players(players), maxTurns(maxTurns) {
+        if (players < Engine::MIN_PLAYERS || players > MAX_PLAYERS) {
+            std::cerr << "BatchSimulator: " << players << " players is out of range" << std::endl;
+            this->players = Engine::MIN_PLAYERS;
+        }
+        std::memset(hands, 0, sizeof(hands));
+        std::memset(handSize, 0, sizeof(handSize));
+        for (int l = 0; l < LANES; l++) {
+            seat[l] = 0;
+            top[l] = 0;
+            forward[l] = 1;
+            turns[l] = 0;
+            live[l] = 0;
+            over[l] = 0;
+        }
+    }
+
+    BatchSimulator(const BatchSimulator&) = delete;
+    BatchSimulator& operator=(const BatchSimulator&) = delete;
+
+    /**
+     * Play games first .. first+count-1, game i seeded with
+     * streamSeed(masterSeed, i) like Tournament. onResult(i, result) is
+     * called as each game ends, in completion order.
+     */
+    template <typename OnResult>
+    void run(uint64_t masterSeed, uint64_t first, uint64_t count, OnResult onResult) {
+        uint64_t next = first;
+        const uint64_t end = first + count;
+        int running = 0;
+        for (int l = 0; l < LANES; l++) {
+            live[l] = 0;
+            if (next < end) {
+                startGame(l, next, streamSeed(masterSeed, next));
+                next++;
+                running++;
+            }
+        }
+
+        while (running > 0) {
+            // Turn limit, then the turn starts (as in beginTurn())
+            for (int l = 0; l < LANES; l++) {
+                int32_t limited = live[l] & (maxTurns > 0) & (turns[l] >= maxTurns);
+                over[l] = limited;
+                turns[l] += live[l] & !limited;
+            }
+
+            playabilityKernel();
+            for (int l = 0; l < LANES; l++) {
+                if (live[l] && !over[l]) {
+                    resolve(l);
+                } else {
+                    effect[l] = NO_PLAY;
+                    effectCount[l] = 0;
+                }
+            }
+            effectsKernel();
+
+            for (int l = 0; l < LANES; l++) {
+                if (effect[l] == DRAW_TWO) penaltyDraws(l);
+                if (!over[l]) continue;
+
+                onResult(gameOf[l], GameResult{ winner[l], turns[l] });
+                over[l] = 0;
+                live[l] = 0;
+                running--;
+                if (next < end) {
+                    startGame(l, next, streamSeed(masterSeed, next));
+                    next++;
+                    running++;
+                }
+            }
+        }
+    }
+
+    /** Which playability kernel this build uses. */
+    static const char* kernelName() {
+#if defined(__AVX512F__) && defined(__AVX512CD__)
+        return "avx512";
+#elif defined(__AVX2__)
+        return "avx2";
+#else
+        return "scalar";
+#endif
+    }
+};
+
+#endif // BATCHSIMULATOR_H
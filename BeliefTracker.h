@@ -0,0 +1,303 @@
+#ifndef BELIEFTRACKER_H
+#define BELIEFTRACKER_H
+
+#include "Card.h"
+#include "Deck.h"
+#include "GameObserver.h"
+#include "GameState.h"
+#include "Hand.h"
+#include "Random.h"
+#include <cstdint>
+#include <utility>
+
+/**
+ * @brief What the public events say about every hidden hand, kept up to
+ * date one event at a time.
+ *
+ * Attach it to an engine as an observer (through ObserverPair if the
+ * engine already has one). It reads only public information: cards
+ * played, how many cards each seat drew, forced draws, the top card and
+ * the size of the discard pile. The cards a seat draws are never looked
+ * at, so one tracker serves every seat at the table; whose view a sample
+ * is for is chosen when sampling.
+ *
+ * It keeps:
+ *   - outside[k]: copies of kind k not in view (in some hand or the draw
+ *     pile), which is the full deck minus the discard pile and top card;
+ *   - per seat, its cards split into up to MAX_GROUPS groups, each with a
+ *     mask of kinds none of its cards can be. A forced draw on top card T
+ *     shows the seat held nothing playable on T, so every card it held
+ *     gets those kinds excluded; cards drawn later start unconstrained.
+ *
+ * When a seat plays a card that more than one group could have held, the
+ * candidate groups merge into one with only the exclusions they share,
+ * so the constraints stay true of the real hand (never over-constrained).
+ * Every update is O(1): at most MAX_GROUPS masks per seat, and 52 counts
+ * only when the discard pile is reshuffled into the draw pile.
+ *
+ * determinize() deals the hidden cards at random for one seat's view,
+ * honouring the groups: the most constrained first, each taking the next
+ * allowed card from a shuffled pool.
+ *
+ * @author Tuan
+ */
+class BeliefTracker : public NullObserver {
+public:
+    static const int MAX_SEATS = GameState::MAX_PLAYERS;
+    static const int MAX_GROUPS = 4;
+
+    /** Cards of one seat that share a set of excluded kinds. */
+    struct Group {
+        uint64_t excluded;
+        int count;
+    };
+
+private:
+    struct SeatBelief {
+        Group groups[MAX_GROUPS];
+        int numGroups;
+        int unconstrained;   // cards with no exclusions (dealt or drawn since the last forced draw)
+    };
+
+    SeatBelief seats[MAX_SEATS];
+    int16_t outside[Card::NUM_KINDS];
+    int16_t discarded[Card::NUM_KINDS];   // kinds in the discard pile
+    int discardCount;
+    int numSeats;
+    Card top;
+
+    static bool allows(const Group& g, int kind) { return ((g.excluded >> kind) & 1) == 0; }
+
+    void removeGroup(SeatBelief& b, int i) {
+        b.groups[i] = b.groups[--b.numGroups];
+    }
+
+    /** The discard pile was shuffled back into the draw pile: its cards are hidden again. */
+    template <typename Game>
+    void checkRecycle(const Game& game) {
+        if (discardCount == 0 || game.discardSize() != 0) return;
+        for (int k = 0; k < Card::NUM_KINDS; k++) {
+            outside[k] += discarded[k];
+            discarded[k] = 0;
+        }
+        discardCount = 0;
+    }
+
+    void discard(Card card) {
+        discarded[card.kind()]++;
+        discardCount++;
+    }
+
+    /** seat played a card of kind: take it from a group that could hold it. */
+    void removeCard(int seat, int kind) {
+        SeatBelief& b = seats[seat];
+        int candidates = b.unconstrained > 0 ? 1 : 0;
+        int only = -1;
+        for (int i = 0; i < b.numGroups; i++) {
+            if (allows(b.groups[i], kind)) {
+                candidates++;
+                only = i;
+            }
+        }
+
+        if (candidates == 0) {
+            // The events contradict the model (a rule variant?): forget what we knew
+            for (int i = 0; i < b.numGroups; i++) b.unconstrained += b.groups[i].count;
+            b.numGroups = 0;
+            b.unconstrained--;
+        } else if (candidates == 1 && b.unconstrained > 0) {
+            b.unconstrained--;
+        } else if (candidates == 1) {
+            if (--b.groups[only].count == 0) removeGroup(b, only);
+        } else {
+            // Any candidate may have held it: merge them, keeping the shared exclusions
+            uint64_t shared = b.unconstrained > 0 ? 0 : ~0ULL;
+            int total = b.unconstrained;
+            for (int i = b.numGroups - 1; i >= 0; i--) {
+                if (!allows(b.groups[i], kind)) continue;
+                shared &= b.groups[i].excluded;
+                total += b.groups[i].count;
+                removeGroup(b, i);
+            }
+            total--;
+            if (b.unconstrained > 0 || shared == 0) {
+                b.unconstrained = total;
+            } else if (total > 0) {
+                b.groups[b.numGroups++] = Group{ shared, total };
+            }
+        }
+        if (b.unconstrained < 0) b.unconstrained = 0;
+    }
+
+    /** seat holds no card of the kinds in mask. */
+    void exclude(int seat, uint64_t mask) {
+        SeatBelief& b = seats[seat];
+        for (int i = 0; i < b.numGroups; i++) b.groups[i].excluded |= mask;
+        if (b.unconstrained > 0) {
+            if (b.numGroups == MAX_GROUPS) {
+                // Full: fold the two oldest groups together
+                b.groups[0].excluded &= b.groups[1].excluded;
+                b.groups[0].count += b.groups[1].count;
+                removeGroup(b, 1);
+            }
+            b.groups[b.numGroups++] = Group{ mask, b.unconstrained };
+            b.unconstrained = 0;
+        }
+    }
+
+public:
+    BeliefTracker() : discardCount(0), numSeats(0) {
+        for (int k = 0; k < Card::NUM_KINDS; k++) {
+            outside[k] = 0;
+            discarded[k] = 0;
+        }
+    }
+
+    // --- Observer hooks ---
+
+    template <typename Game>
+    void onGameStart(const Game& game) {
+        numSeats = game.playerCount();
+        for (int k = 0; k < Card::NUM_KINDS; k++) {
+            outside[k] = static_cast<int16_t>(game.copiesOf(k));
+            discarded[k] = 0;
+        }
+        discardCount = 0;
+        top = game.topCard();
+        outside[top.kind()]--;
+        for (int s = 0; s < numSeats; s++) {
+            seats[s].numGroups = 0;
+            seats[s].unconstrained = game.player(s).handSize();
+        }
+    }
+
+    template <typename Game>
+    void onForcedDraw(const Game& game, int seat) {
+        exclude(seat, Hand::playableOn(game.topCard()));
+    }
+
+    template <typename Game>
+    void onCardDrawn(const Game& game, int seat, Card) {
+        checkRecycle(game);
+        seats[seat].unconstrained++;
+    }
+
+    template <typename Game>
+    void onCardsPlayed(const Game&, int seat, const Card* cards, int count) {
+        discard(top);
+        for (int i = 0; i < count; i++) {
+            outside[cards[i].kind()]--;
+            removeCard(seat, cards[i].kind());
+            if (i + 1 < count) discard(cards[i]);
+        }
+        top = cards[count - 1];
+    }
+
+    template <typename Game>
+    void onEffect(const Game& game, CardType type, int, int target, int drawn) {
+        if (type != DRAW_TWO) return;
+        checkRecycle(game);
+        seats[target].unconstrained += drawn;
+    }
+
+    // --- Queries ---
+
+    /** Copies of kind not in view: in some hand or in the draw pile. */
+    int unseen(int kind) const { return outside[kind]; }
+
+    /** Cards seat is believed to hold, constrained or not. */
+    int cardsOf(int seat) const {
+        const SeatBelief& b = seats[seat];
+        int total = b.unconstrained;
+        for (int i = 0; i < b.numGroups; i++) total += b.groups[i].count;
+        return total;
+    }
+
+    int groupCount(int seat) const { return seats[seat].numGroups; }
+    const Group& group(int seat, int i) const { return seats[seat].groups[i]; }
+    int unconstrainedCards(int seat) const { return seats[seat].unconstrained; }
+
+    /** True when seat certainly holds no card of kind. */
+    bool excludes(int seat, int kind) const {
+        const SeatBelief& b = seats[seat];
+        if (b.unconstrained > 0 || b.numGroups == 0) return false;
+        for (int i = 0; i < b.numGroups; i++) {
+            if (allows(b.groups[i], kind)) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Replace every hand but viewer's and the draw pile in world with a
+     * random deal consistent with the beliefs. world should be the real
+     * position (its own hands give the sizes). Returns false if some
+     * constrained card could not be matched and was dealt unconstrained.
+     */
+    bool determinize(GameState& world, int viewer, Xoshiro256& rng) const {
+        Card hidden[Deck::CAPACITY];
+        int n = 0;
+        const Hand& own = world.players[viewer].hand;
+        for (int k = 0; k < Card::NUM_KINDS; k++) {
+            for (int c = own.count(k); c < outside[k] && n < Deck::CAPACITY; c++) hidden[n++] = Card::fromKind(k);
+        }
+        for (int i = n - 1; i > 0; i--) {
+            std::swap(hidden[i], hidden[rng.bounded(static_cast<uint32_t>(i + 1))]);
+        }
+
+        struct Pending {
+            uint64_t excluded;
+            int seat;
+            int count;
+        };
+        Pending pending[MAX_SEATS * MAX_GROUPS];
+        int numPending = 0;
+        int rest[MAX_SEATS];   // cards still to deal to each seat
+        for (int seat = 0; seat < world.numPlayers; seat++) {
+            rest[seat] = world.players[seat].handSize();
+            if (seat == viewer) continue;
+            world.players[seat].hand.clear();
+            if (seat >= numSeats) continue;
+            const SeatBelief& b = seats[seat];
+            for (int i = 0; i < b.numGroups; i++) {
+                Pending p{ b.groups[i].excluded, seat, b.groups[i].count };
+                // Insertion sort: most excluded kinds first
+                int j = numPending++;
+                while (j > 0 && __builtin_popcountll(pending[j - 1].excluded) < __builtin_popcountll(p.excluded)) {
+                    pending[j] = pending[j - 1];
+                    j--;
+                }
+                pending[j] = p;
+            }
+        }
+
+        bool consistent = true;
+        int pos = 0;
+        for (int g = 0; g < numPending; g++) {
+            const Pending& p = pending[g];
+            for (int c = 0; c < p.count && rest[p.seat] > 0 && pos < n; c++) {
+                // The pool is shuffled, so the first allowed card is a uniform pick among them
+                int j = pos;
+                while (j < n && ((p.excluded >> hidden[j].kind()) & 1)) j++;
+                if (j == n) {
+                    consistent = false;
+                    j = pos;
+                }
+                std::swap(hidden[pos], hidden[j]);
+                world.players[p.seat].hand.add(hidden[pos++]);
+                rest[p.seat]--;
+            }
+        }
+        for (int seat = 0; seat < world.numPlayers; seat++) {
+            if (seat == viewer) continue;
+            while (rest[seat] > 0 && pos < n) {
+                world.players[seat].hand.add(hidden[pos++]);
+                rest[seat]--;
+            }
+            if (rest[seat] > 0) consistent = false;
+        }
+        world.deck.replaceDrawPile(hidden + pos, n - pos);
+        return consistent;
+    }
+};
+
+#endif // BELIEFTRACKER_H
@@ -0,0 +1,85 @@
+#ifndef BOTPOLICIES_H
+#define BOTPOLICIES_H
+
+#include "PlayerPolicy.h"
+#include "Random.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Plays the first playable card and stacks every matching card on it.
+ *
+ * Deterministic and cheap; useful as a baseline opponent.
+ *
+ * @author Tuan
+ */
+class GreedyPolicy : public PlayerPolicy {
+public:
+    void chooseCards(const GameState& state, int seat, std::vector<int>& indices) override {
+        const Player& player = state.players[seat];
+        indices.clear();
+        uint64_t playable = player.hand.playableKinds(state.topCard);
+        if (playable == 0) return;
+        if (state.penalty > 0) {
+            // Pass an owed penalty on with a Draw Two when there is one
+            uint64_t drawTwos = player.hand.stackKinds(Card(RED, -1, DRAW_TWO));
+            if (drawTwos) playable = drawTwos;
+        }
+
+        int leadKind = __builtin_ctzll(playable);
+        int lead = player.hand.indexOf(leadKind);
+        indices.push_back(lead);
+
+        uint64_t stack = player.hand.stackKinds(Card::fromKind(leadKind));
+        while (stack) {
+            int k = __builtin_ctzll(stack);
+            int first = player.hand.indexOf(k);
+            for (int c = 0; c < player.hand.count(k); c++) {
+                if (first + c != lead) indices.push_back(first + c);
+            }
+            stack &= stack - 1;
+        }
+    }
+
+    bool playDrawnCard(const GameState&, int, const Card&) override { return true; }
+};
+
+/**
+ * @brief Plays a uniformly random playable card, without stacking.
+ * @author Tuan
+ */
+class RandomPolicy : public PlayerPolicy {
+private:
+    Xoshiro256 rng;
+
+public:
+    explicit RandomPolicy(uint64_t seed = 0) : rng(seed) {}
+
+    void newGame(uint64_t seed) override { rng.seed(seed); }
+
+    void chooseCards(const GameState& state, int seat, std::vector<int>& indices) override {
+        const Hand& hand = state.players[seat].hand;
+        indices.clear();
+        uint64_t playable = hand.playableKinds(state.topCard);
+        int cards = 0;
+        for (uint64_t kinds = playable; kinds; kinds &= kinds - 1) cards += hand.count(__builtin_ctzll(kinds));
+        if (cards == 0) return;
+
+        // The pick-th playable card, counting copies in hand order
+        int pick = static_cast<int>(rng.bounded(static_cast<uint32_t>(cards)));
+        for (uint64_t kinds = playable; kinds; kinds &= kinds - 1) {
+            int k = __builtin_ctzll(kinds);
+            if (pick < hand.count(k)) {
+                indices.push_back(hand.indexOf(k) + pick);
+                return;
+            }
+            pick -= hand.count(k);
+        }
+    }
+
+    bool playDrawnCard(const GameState&, int, const Card&) override {
+        return (rng() & 1) != 0;
+    }
+};
+
+#endif // BOTPOLICIES_H
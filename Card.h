@@ -1,6 +1,7 @@
 #ifndef CARD_H
 #define CARD_H
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -11,62 +12,114 @@
 enum CardColor { RED, BLUE, GREEN, YELLOW };
 enum CardType { NUMBER, SKIP, REVERSE, DRAW_TWO };
 
+/**
+ * @brief Lookup tables for all 52 card kinds, built at compile time.
+ *
+ * A kind is color * 13 + rank, where rank is 0-9 for numbers and 10, 11,
+ * 12 for Skip, Reverse and Draw Two. Row k of each mask table has bit j
+ * set when kind j relates to kind k, so a rule check is a single load
+ * and shift.
+ *
+ * @author Tam
+ */
+struct CardTables {
+    static constexpr int NUM_KINDS = 52;
+    static constexpr int KINDS_PER_COLOR = 13;
+
+    uint64_t playableOn[NUM_KINDS];      // kinds that may be played on kind k
+    uint64_t stackableWith[NUM_KINDS];   // kinds that stack with kind k
+    uint8_t color[NUM_KINDS];
+    uint8_t type[NUM_KINDS];
+    int8_t value[NUM_KINDS];
+
+    constexpr CardTables() : playableOn(), stackableWith(), color(), type(), value() {
+        for (int k = 0; k < NUM_KINDS; k++) {
+            int rank = k % KINDS_PER_COLOR;
+            color[k] = static_cast<uint8_t>(k / KINDS_PER_COLOR);
+            type[k] = static_cast<uint8_t>(rank <= 9 ? NUMBER : rank - 9);
+            value[k] = static_cast<int8_t>(rank <= 9 ? rank : -1);
+        }
+        for (int k = 0; k < NUM_KINDS; k++) {
+            for (int j = 0; j < NUM_KINDS; j++) {
+                bool sameColor = color[j] == color[k];
+                bool sameRank = j % KINDS_PER_COLOR == k % KINDS_PER_COLOR;
+                if (sameColor || sameRank) playableOn[k] |= 1ULL << j;
+                if (sameRank) stackableWith[k] |= 1ULL << j;
+            }
+        }
+    }
+};
+
+inline constexpr CardTables CARD_TABLES{};
+
 /**
  * @brief Represents a single UNO card with color, value, and type.
+ *
+ * Stored in one byte: the card's kind (color * 13 + rank). Color, type
+ * and value are decoded through CARD_TABLES.
+ *
  * @author Tam
  */
 class Card {
+private:
+    uint8_t code;
+
+    explicit constexpr Card(uint8_t code) : code(code) {}
+
 public:
-    CardColor color;
-    int value;
-    CardType type;
+    /** Number of distinct cards: 4 colors x (0-9, Skip, Reverse, Draw Two). */
+    static const int NUM_KINDS = CardTables::NUM_KINDS;
+    static const int KINDS_PER_COLOR = CardTables::KINDS_PER_COLOR;
 
-    Card() : color(RED), value(0), type(NUMBER) {}
+    constexpr Card() : code(0) {}
 
-    Card(CardColor color, int value, CardType type)
-        : color(color), value(value), type(type) {}
+    constexpr Card(CardColor color, int value, CardType type)
+        : code(static_cast<uint8_t>(static_cast<int>(color) * KINDS_PER_COLOR +
+                                    (type == NUMBER ? value : 9 + static_cast<int>(type)))) {}
 
-    bool operator==(const Card& other) const {
-        return color == other.color && value == other.value && type == other.type;
-    }
+    CardColor color() const { return static_cast<CardColor>(CARD_TABLES.color[code]); }
+    CardType type() const { return static_cast<CardType>(CARD_TABLES.type[code]); }
+    int value() const { return CARD_TABLES.value[code]; }
+
+    /** Dense index 0..51 of this card: color * 13 + rank (0-9, then Skip, Reverse, Draw Two). */
+    constexpr int kind() const { return code; }
+
+    /** Inverse of kind(). */
+    static constexpr Card fromKind(int kind) { return Card(static_cast<uint8_t>(kind)); }
+
+    bool operator==(const Card& other) const { return code == other.code; }
+    bool operator!=(const Card& other) const { return code != other.code; }
 
     /** Check if this card can be played on the given top card. */
     bool isPlayable(const Card& topCard) const {
-        if (color == topCard.color) return true;
-        if (type == NUMBER && topCard.type == NUMBER && value == topCard.value) return true;
-        if (type != NUMBER && type == topCard.type) return true;
-        return false;
+        return (CARD_TABLES.playableOn[topCard.code] >> code) & 1;
     }
 
     /** Check if this card can be stacked with another (same number or same action type). */
     bool matchesForStacking(const Card& other) const {
-        if (type == NUMBER && other.type == NUMBER) return value == other.value;
-        return type != NUMBER && type == other.type;
+        return (CARD_TABLES.stackableWith[other.code] >> code) & 1;
     }
 
-    std::string colorToString() const {
-        switch (color) {
-            case RED:    return "Red";
-            case BLUE:   return "Blue";
-            case GREEN:  return "Green";
-            case YELLOW: return "Yellow";
-        }
-        return "Unknown";
+    const char* colorName() const {
+        static const char* const NAMES[] = { "Red", "Blue", "Green", "Yellow" };
+        return NAMES[CARD_TABLES.color[code]];
     }
 
-    std::string typeToString() const {
-        switch (type) {
-            case SKIP:     return "Skip";
-            case REVERSE:  return "Reverse";
-            case DRAW_TWO: return "Draw Two";
-            default:       return std::to_string(value);
-        }
+    const char* typeName() const {
+        static const char* const NAMES[] = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9",
+                                             "Skip", "Reverse", "Draw Two" };
+        return NAMES[code % KINDS_PER_COLOR];
     }
 
+    std::string colorToString() const { return colorName(); }
+    std::string typeToString() const { return typeName(); }
+
     friend std::ostream& operator<<(std::ostream& os, const Card& card) {
-        os << "[" << card.colorToString() << " " << card.typeToString() << "]";
+        os << "[" << card.colorName() << " " << card.typeName() << "]";
         return os;
     }
 };
 
+static_assert(sizeof(Card) == 1, "Card must pack into one byte");
+
 #endif // CARD_H
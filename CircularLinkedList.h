@@ -2,7 +2,10 @@
 #define CIRCULARLINKEDLIST_H
 
 #include "Node.h"
+#include "NodePool.h"
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 
 /**
  * @brief Circular singly linked list with traversal direction support.
@@ -10,10 +13,14 @@
  * Supports forward/backward traversal via a direction flag,
  * making it suitable for turn-based games like UNO.
  *
+ * Nodes come from Alloc (see NodePool.h); the default slab pool recycles
+ * them per thread, and clear()/the destructor return the whole ring at once.
+ *
  * @tparam T The data type stored in each node.
+ * @tparam Alloc Node allocator providing create, destroy and destroyChain.
  * @author Khang
  */
-template <typename T>
+template <typename T, typename Alloc = NodePool<T>>
 class CircularLinkedList {
 private:
     Node<T>* head;
@@ -22,35 +29,101 @@ private:
     int count;
     bool forward;
 
+    /** Forget all nodes without freeing them (they now belong to another list). */
+    void detach() {
+        head = nullptr;
+        tail = nullptr;
+        current = nullptr;
+        count = 0;
+    }
+
+    /** Take the node at it out of the ring without freeing it. */
+    template <typename It>
+    Node<T>* unlink(It it) {
+        Node<T>* node = it.node;
+        if (count == 1) {
+            detach();
+            return node;
+        }
+        it.prev->next = node->next;
+        if (node == head) head = node->next;
+        if (node == tail) tail = it.prev;
+        if (node == current) current = node->next;
+        count--;
+        return node;
+    }
+
 public:
     CircularLinkedList()
         : head(nullptr), tail(nullptr), current(nullptr),
           count(0), forward(true) {}
 
     ~CircularLinkedList() {
-        if (head == nullptr) return;
-
-        tail->next = nullptr;
-        Node<T>* curr = head;
-        while (curr != nullptr) {
-            Node<T>* next = curr->next;
-            delete curr;
-            curr = next;
-        }
-        head = nullptr;
-        tail = nullptr;
-        current = nullptr;
-        count = 0;
+        clear();
     }
 
     // Prevent shallow copies (pointers would be shared)
     CircularLinkedList(const CircularLinkedList&) = delete;
     CircularLinkedList& operator=(const CircularLinkedList&) = delete;
 
+    /**
+     * @brief Forward iterator from head to tail (one lap of the ring).
+     *
+     * Also remembers the previous node, so erase() and splice() at the
+     * iterator's position are O(1) in a singly linked ring. end() has no
+     * node (its previous node is the tail), so it stays end() whatever is
+     * erased, and iterators of different lists never compare equal.
+     */
+    template <typename V>
+    class Iterator {
+    private:
+        friend class CircularLinkedList;
+        template <typename> friend class Iterator;
+        const CircularLinkedList* list;
+        Node<T>* prev;
+        Node<T>* node;   // nullptr at end()
+
+        Iterator(const CircularLinkedList* list, Node<T>* prev, Node<T>* node)
+            : list(list), prev(prev), node(node) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        Iterator() : list(nullptr), prev(nullptr), node(nullptr) {}
+
+        // Allow iterator -> const_iterator
+        operator Iterator<const T>() const { return Iterator<const T>(list, prev, node); }
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+
+        Iterator& operator++() {
+            prev = node;
+            node = (node == list->tail) ? nullptr : node->next;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return node == other.node && list == other.list; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
     // --- Insertion ---
 
     void insertBack(T value) {
-        Node<T>* newNode = new Node<T>(value);
+        Node<T>* newNode = Alloc::create(value);
         if (head == nullptr) {
             head = newNode;
             tail = newNode;
@@ -65,7 +138,7 @@ public:
     }
 
     void insertFront(T value) {
-        Node<T>* newNode = new Node<T>(value);
+        Node<T>* newNode = Alloc::create(value);
         if (head == nullptr) {
             head = newNode;
             tail = newNode;
@@ -91,7 +164,7 @@ public:
         for (int i = 0; i < index - 1; i++) {
             prev = prev->next;
         }
-        Node<T>* newNode = new Node<T>(value);
+        Node<T>* newNode = Alloc::create(value);
         newNode->next = prev->next;
         prev->next = newNode;
         count++;
@@ -99,12 +172,24 @@ public:
 
     // --- Removal ---
 
+    /** Remove every element and reset the traversal direction. */
+    void clear() {
+        forward = true;
+        if (head == nullptr) return;
+
+        Alloc::destroyChain(head, tail);
+        head = nullptr;
+        tail = nullptr;
+        current = nullptr;
+        count = 0;
+    }
+
     void removeFront() {
         if (head == nullptr) return;
 
         if (count == 1) {
             if (current == head) current = nullptr;
-            delete head;
+            Alloc::destroy(head);
             head = nullptr;
             tail = nullptr;
             count = 0;
@@ -115,7 +200,7 @@ public:
         head = head->next;
         tail->next = head;
         if (current == toDelete) current = head;
-        delete toDelete;
+        Alloc::destroy(toDelete);
         count--;
     }
 
@@ -141,7 +226,7 @@ public:
             current = prev->next;
         }
 
-        delete toDelete;
+        Alloc::destroy(toDelete);
         count--;
 
         if (count == 0) {
@@ -168,7 +253,7 @@ public:
                 if (curr == current) {
                     current = prev->next;
                 }
-                delete curr;
+                Alloc::destroy(curr);
                 count--;
                 return;
             }
@@ -199,15 +284,92 @@ public:
             std::cout << "(empty)" << std::endl;
             return;
         }
-        Node<T>* temp = head;
-        for (int i = 0; i < count; i++) {
-            std::cout << temp->data;
-            if (i < count - 1) std::cout << ", ";
-            temp = temp->next;
+        int i = 0;
+        for (const T& value : *this) {
+            std::cout << value;
+            if (++i < count) std::cout << ", ";
         }
         std::cout << std::endl;
     }
 
+    // --- Iteration and bulk operations ---
+
+    iterator begin() { return iterator(this, tail, head); }
+    iterator end() { return iterator(this, tail, nullptr); }
+    const_iterator begin() const { return const_iterator(this, tail, head); }
+    const_iterator end() const { return const_iterator(this, tail, nullptr); }
+
+    /** Remove the element at pos in O(1). Returns the iterator after it. */
+    iterator erase(iterator pos) {
+        Node<T>* toDelete = pos.node;
+        if (count == 1) {
+            Alloc::destroy(toDelete);
+            head = nullptr;
+            tail = nullptr;
+            current = nullptr;
+            count = 0;
+            return end();
+        }
+
+        Node<T>* next = toDelete->next;
+        bool last = toDelete == tail;
+        pos.prev->next = next;
+        if (toDelete == head) head = next;
+        if (last) tail = pos.prev;
+        if (toDelete == current) current = next;
+
+        Alloc::destroy(toDelete);
+        count--;
+        return last ? end() : iterator(this, pos.prev, next);
+    }
+
+    /** Move every element of other in front of pos in O(1). other ends up empty. */
+    void splice(iterator pos, CircularLinkedList& other) {
+        if (&other == this || other.head == nullptr) return;
+
+        if (head == nullptr) {
+            head = other.head;
+            tail = other.tail;
+            current = head;
+        } else if (pos.node == head || pos.node == nullptr) {
+            // Both ends are the gap between tail and head
+            tail->next = other.head;
+            other.tail->next = head;
+            if (pos.node == head) head = other.head;
+            else tail = other.tail;
+        } else {
+            pos.prev->next = other.head;
+            other.tail->next = pos.node;
+        }
+        count += other.count;
+        other.detach();
+    }
+
+    /** Move the single element at it from other (a different list) to in front of pos in O(1). */
+    void splice(iterator pos, CircularLinkedList& other, iterator it) {
+        if (&other == this || other.head == nullptr) return;
+        Node<T>* moved = other.unlink(it);
+
+        if (head == nullptr) {
+            head = moved;
+            tail = moved;
+            moved->next = moved;
+            current = head;
+        } else if (pos.node == head || pos.node == nullptr) {
+            tail->next = moved;
+            moved->next = head;
+            if (pos.node == head) head = moved;
+            else tail = moved;
+        } else {
+            pos.prev->next = moved;
+            moved->next = pos.node;
+        }
+        count++;
+    }
+
+    /** Move every element of other to the back of this list in O(1). */
+    void append(CircularLinkedList& other) { splice(end(), other); }
+
     // --- Traversal (UNO turn management) ---
 
     T getCurrent() const {
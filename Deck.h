@@ -2,85 +2,193 @@
 #define DECK_H
 
 #include "Card.h"
-#include "CircularLinkedList.h"
-#include <algorithm>
-#include <cstdlib>
+#include "Instrument.h"
+#include "Random.h"
+#include <cstdint>
 #include <iostream>
-#include <vector>
+#include <utility>
 
 /**
- * @brief Manages the draw pile: builds, shuffles, and deals cards.
+ * @brief Manages the draw and discard piles: builds, shuffles, and deals cards.
+ *
+ * Cards live in fixed arrays with the top of each pile at the back.
+ * shuffle() is lazy: it only switches the deck to random draws, and each
+ * drawFromDeck() then does one step of Fisher-Yates (swap a random
+ * remaining card to the top and pop it). The draw order has the same
+ * distribution as a full shuffle, but cards that are never drawn cost
+ * nothing and starting a reshuffle is O(1). shuffleAll() does the whole
+ * shuffle up front when a fixed order is wanted.
+ *
+ * Played cards go to the discard pile. When the draw pile runs out, the
+ * two piles trade roles (one index flip, no copies) and the new draw pile
+ * is shuffled lazily, so a game never runs out of cards while any are
+ * discarded.
+ *
+ * The deck holds no pointers, so copying it (e.g. inside a GameState
+ * snapshot) is a flat memcpy. A copy also carries the generator state and
+ * will draw the same cards as the original until one of them is reseeded.
+ *
  * @author Tam
  */
 class Deck {
+public:
+    /** Cards in a full deck, and the capacity of each pile. */
+    static const int CAPACITY = 100;
+
 private:
     static const int NUM_COLORS = 4;
     static const int MAX_NUMBER = 9;
     static const int ACTION_COPIES = 2;
 
-    CircularLinkedList<Card> cards;
+    Card piles[2][CAPACITY];
+    int pileSize[2];
+    Xoshiro256 rng;
+    uint8_t drawPile;   // index of the draw pile in piles; the other is the discard pile
+    bool randomDraws;   // set by shuffle(): draw a random remaining card
+
+    // What the last build() put in, for copiesOf()
+    uint8_t builtMaxNumber;
+    uint8_t builtZeroCopies;
+    uint8_t builtNumberCopies;
+    uint8_t builtActionCopies;
+
+    Card* cards() { return piles[drawPile]; }
+    int& count() { return pileSize[drawPile]; }
+
+    void push(int pile, Card card, const char* caller) {
+        if (pileSize[pile] >= CAPACITY) {
+            std::cerr << caller << ": pile is full" << std::endl;
+            return;
+        }
+        piles[pile][pileSize[pile]++] = card;
+    }
 
 public:
-    Deck() {}
+    Deck()
+        : pileSize{ 0, 0 }, drawPile(0), randomDraws(false), builtMaxNumber(MAX_NUMBER),
+          builtZeroCopies(1), builtNumberCopies(2), builtActionCopies(ACTION_COPIES) {}
+
+    /** Copies of a card kind in the full deck as last built (the standard deck before any build). */
+    int copiesOf(int kind) const {
+        int rank = kind % Card::KINDS_PER_COLOR;
+        if (rank == 0) return builtZeroCopies;
+        if (rank <= MAX_NUMBER) return rank <= builtMaxNumber ? builtNumberCopies : 0;
+        return builtActionCopies;
+    }
+
+    /** Reseed the deck's generator. */
+    void seed(uint64_t value) { rng.seed(value); }
 
     /** Build a standard UNO-Lite deck (76 number + 24 action = 100 cards). */
     void build() {
+        build(MAX_NUMBER, 1, 2, ACTION_COPIES);
+    }
+
+    /**
+     * Build a custom deck: per color zeroCopies 0s, numberCopies each of
+     * 1..maxNumber and actionCopies each of Skip, Reverse and Draw Two.
+     * copiesOf() then describes this deck.
+     */
+    void build(int maxNumber, int zeroCopies, int numberCopies, int actionCopies) {
+        pileSize[0] = pileSize[1] = 0;
+        drawPile = 0;
+        randomDraws = false;
+        builtMaxNumber = static_cast<uint8_t>(maxNumber);
+        builtZeroCopies = static_cast<uint8_t>(zeroCopies);
+        builtNumberCopies = static_cast<uint8_t>(numberCopies);
+        builtActionCopies = static_cast<uint8_t>(actionCopies);
         CardColor colors[] = { RED, BLUE, GREEN, YELLOW };
 
         for (int c = 0; c < NUM_COLORS; c++) {
-            cards.insertBack(Card(colors[c], 0, NUMBER));
+            for (int i = 0; i < zeroCopies; i++) {
+                addCard(Card(colors[c], 0, NUMBER));
+            }
 
-            for (int v = 1; v <= MAX_NUMBER; v++) {
-                cards.insertBack(Card(colors[c], v, NUMBER));
-                cards.insertBack(Card(colors[c], v, NUMBER));
+            for (int v = 1; v <= maxNumber; v++) {
+                for (int i = 0; i < numberCopies; i++) {
+                    addCard(Card(colors[c], v, NUMBER));
+                }
             }
 
-            for (int i = 0; i < ACTION_COPIES; i++) {
-                cards.insertBack(Card(colors[c], -1, SKIP));
-                cards.insertBack(Card(colors[c], -1, REVERSE));
-                cards.insertBack(Card(colors[c], -1, DRAW_TWO));
+            for (int i = 0; i < actionCopies; i++) {
+                addCard(Card(colors[c], -1, SKIP));
+                addCard(Card(colors[c], -1, REVERSE));
+                addCard(Card(colors[c], -1, DRAW_TWO));
             }
         }
     }
 
-    /** Shuffle using Fisher-Yates algorithm with rand(). */
+    /** Shuffle lazily: O(1) now, one Fisher-Yates step per draw. */
     void shuffle() {
-        int n = cards.size();
-        std::vector<Card> temp;
-        for (int i = 0; i < n; i++) {
-            temp.push_back(cards.get(i));
-        }
+        UNO_COUNT(SHUFFLES);
+        randomDraws = true;
+    }
 
-        while (!cards.isEmpty()) {
-            cards.removeFront();
+    /** Shuffle the whole deck now using Fisher-Yates. */
+    void shuffleAll() {
+        UNO_TIMED(TIMER_SHUFFLE);
+        UNO_COUNT(SHUFFLES);
+        Card* c = cards();
+        for (int i = count() - 1; i > 0; i--) {
+            int j = static_cast<int>(rng.bounded(static_cast<uint32_t>(i + 1)));
+            std::swap(c[i], c[j]);
         }
+        randomDraws = false;
+    }
 
-        for (int i = n - 1; i > 0; i--) {
-            int j = rand() % (i + 1);
-            std::swap(temp[i], temp[j]);
-        }
+    void addCard(Card card) {
+        push(drawPile, card, "addCard");
+    }
 
-        for (int i = 0; i < n; i++) {
-            cards.insertBack(temp[i]);
-        }
+    /** Put a played card on the discard pile. */
+    void discard(Card card) {
+        push(drawPile ^ 1, card, "discard");
     }
 
-    void addCard(Card card) {
-        cards.insertBack(card);
+    /**
+     * Replace the draw pile with n given cards, to be drawn in random order.
+     * Search players use this to resample the cards they cannot see.
+     */
+    void replaceDrawPile(const Card* replacement, int n) {
+        pileSize[drawPile] = 0;
+        for (int i = 0; i < n; i++) addCard(replacement[i]);
+        shuffle();
+    }
+
+    /** Turn the discard pile into the draw pile. Returns false if it is empty. */
+    bool recycleDiscards() {
+        if (pileSize[drawPile ^ 1] == 0) return false;
+        UNO_TIMED(TIMER_SHUFFLE);
+        UNO_COUNT(RESHUFFLES);
+        pileSize[drawPile] = 0;
+        drawPile ^= 1;
+        shuffle();
+        return true;
     }
 
     Card drawFromDeck() {
-        if (cards.isEmpty()) {
+        UNO_TIMED(TIMER_DRAW);
+        UNO_COUNT(DRAWS);
+        if (count() == 0 && !recycleDiscards()) {
             std::cerr << "drawFromDeck: deck is empty" << std::endl;
             return Card();
         }
-        Card top = cards.get(0);
-        cards.removeFront();
-        return top;
+        Card* c = cards();
+        int n = count();
+        if (randomDraws) {
+            std::swap(c[rng.bounded(static_cast<uint32_t>(n))], c[n - 1]);
+        }
+        count()--;
+        return c[n - 1];
     }
 
-    bool isEmpty() const { return cards.isEmpty(); }
-    int size() const { return cards.size(); }
+    /** True when neither the draw pile nor the discard pile has a card. */
+    bool isEmpty() const { return pileSize[0] == 0 && pileSize[1] == 0; }
+    int size() const { return pileSize[drawPile]; }
+    int discardSize() const { return pileSize[drawPile ^ 1]; }
+
+    /** Card i of the discard pile (0 = oldest). Played cards are public. */
+    Card discardAt(int i) const { return piles[drawPile ^ 1][i]; }
 };
 
 #endif // DECK_H
@@ -0,0 +1,724 @@
+#ifndef ENDGAMESOLVER_H
+#define ENDGAMESOLVER_H
+
+#include "BotPolicies.h"
+#include "Card.h"
+#include "Deck.h"
+#include "GameState.h"
+#include "Hand.h"
+#include "MoveGen.h"
+#include "PlayerPolicy.h"
+#include "Random.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Random keys for Zobrist hashing of endgame positions, built at
+ * compile time.
+ *
+ * One key per copy of a kind in each hand, per top card, per seat to move
+ * and one for reversed play. A position hashes to the XOR of the keys of
+ * what is in it, so moving a card updates the hash with one or two XORs.
+ *
+ * @author Tuan
+ */
+struct ZobristKeys {
+    static constexpr int SEATS = 2;
+    static constexpr int MAX_COPIES = 2;   // copies of one kind in the standard deck
+
+    uint64_t hand[SEATS][Card::NUM_KINDS][MAX_COPIES];
+    uint64_t top[Card::NUM_KINDS];
+    uint64_t turn[SEATS];
+    uint64_t reversed;
+
+    static constexpr uint64_t mix(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    constexpr ZobristKeys() : hand(), top(), turn(), reversed(0) {
+        uint64_t state = 0x2B992DDFA23249D6ULL;
+        for (int k = 0; k < Card::NUM_KINDS; k++) {
+            for (int c = 0; c < MAX_COPIES; c++) {
+                for (int s = 0; s < SEATS; s++) hand[s][k][c] = mix(state);
+            }
+            top[k] = mix(state);
+        }
+        for (int s = 0; s < SEATS; s++) turn[s] = mix(state);
+        reversed = mix(state);
+    }
+};
+
+inline constexpr ZobristKeys ZOBRIST_KEYS{};
+
+/**
+ * @brief A two-player position with every card known, including the
+ * order the deck will deal them in.
+ *
+ * The deck is a copy of the game's (generator included), so every draw
+ * here is the card the real game would deal. hash covers the hands, top
+ * card, seat to move and direction; the solver adds the deck. Every
+ * change goes through the methods below, which keep hash up to date and
+ * mirror the engine's order of discards.
+ *
+ * @author Tuan
+ */
+struct EndgamePosition {
+    static constexpr int SEATS = ZobristKeys::SEATS;
+
+    Hand hands[SEATS];
+    Deck deck;
+    Card top;
+    int turn;
+    int drawn;       // cards drawn since the position was loaded
+    bool forward;
+    bool recycled;   // the discard pile has been shuffled back since loading
+    uint64_t hash;
+
+    /**
+     * Take the position from a standard two-player game. Returns false
+     * (and writes why to std::cerr) for other tables, and for a seat that
+     * owes a stacked penalty, which only other rules leave pending.
+     */
+    bool load(const GameState& state) {
+        if (state.numPlayers != SEATS) {
+            std::cerr << "load: endgames are solved for " << SEATS << " players, not "
+                      << state.numPlayers << std::endl;
+            return false;
+        }
+        if (state.penalty != 0) {
+            std::cerr << "load: a penalty of " << state.penalty
+                      << " is owed; endgames are solved under the standard rules" << std::endl;
+            return false;
+        }
+        for (int s = 0; s < SEATS; s++) hands[s] = state.players[s].hand;
+        deck = state.deck;
+        top = state.topCard;
+        turn = state.order.current();
+        drawn = 0;
+        forward = state.order.isForward();
+        recycled = false;
+        hash = computeHash();
+        return true;
+    }
+
+    /** Hash from scratch; the methods below keep hash equal to it. */
+    uint64_t computeHash() const {
+        uint64_t h = ZOBRIST_KEYS.top[top.kind()] ^ ZOBRIST_KEYS.turn[turn];
+        if (!forward) h ^= ZOBRIST_KEYS.reversed;
+        for (int s = 0; s < SEATS; s++) {
+            for (int k = 0; k < Card::NUM_KINDS; k++) {
+                for (int c = 0; c < hands[s].count(k); c++) h ^= ZOBRIST_KEYS.hand[s][k][c];
+            }
+        }
+        return h;
+    }
+
+    int other() const { return 1 - turn; }
+
+    void addCard(int seat, int kind) {
+        hash ^= ZOBRIST_KEYS.hand[seat][kind][hands[seat].count(kind)];
+        hands[seat].add(Card::fromKind(kind));
+    }
+
+    void removeCard(int seat, int kind) {
+        hands[seat].removeKind(kind);
+        hash ^= ZOBRIST_KEYS.hand[seat][kind][hands[seat].count(kind)];
+    }
+
+    /** seat draws the deck's next card, unless the deck is empty. */
+    bool draw(int seat, Card& card) {
+        if (deck.isEmpty()) return false;
+        if (deck.size() == 0) recycled = true;
+        card = deck.drawFromDeck();
+        drawn++;
+        addCard(seat, card.kind());
+        return true;
+    }
+
+    /** The seat to move plays cards (lead first), as answerCards() does. */
+    void play(const Card* cards, int count) {
+        for (int i = 0; i < count; i++) removeCard(turn, cards[i].kind());
+        deck.discard(top);
+        for (int i = 0; i + 1 < count; i++) deck.discard(cards[i]);
+        hash ^= ZOBRIST_KEYS.top[top.kind()] ^ ZOBRIST_KEYS.top[cards[count - 1].kind()];
+        top = cards[count - 1];
+    }
+
+    void setTurn(int seat) {
+        hash ^= ZOBRIST_KEYS.turn[turn] ^ ZOBRIST_KEYS.turn[seat];
+        turn = seat;
+    }
+
+    void reverse() {
+        forward = !forward;
+        hash ^= ZOBRIST_KEYS.reversed;
+    }
+};
+
+/**
+ * @brief Search limits for EndgameSolver.
+ * @author Tuan
+ */
+struct EndgameConfig {
+    int maxDepth;        // turns searched ahead at most
+    uint64_t maxNodes;   // nodes per solve over all threads (0 = no limit)
+    int threads;         // search threads, including the caller's
+    int tableBits;       // the transposition table has 2^tableBits slots
+
+    EndgameConfig() : maxDepth(64), maxNodes(2000000), threads(1), tableBits(20) {}
+};
+
+/**
+ * @brief What a solve found for the seat to move.
+ * @author Tuan
+ */
+struct EndgameResult {
+    static const int WIN = 1;
+    static const int UNKNOWN = 0;   // no line decided within the limits
+    static const int LOSS = -1;
+
+    int outcome;
+    Play best;        // a move reaching outcome
+    int depth;        // turns searched ahead
+    uint64_t nodes;   // positions searched, over all threads
+
+    EndgameResult() : outcome(UNKNOWN), best(Play()), depth(0), nodes(0) {}
+
+    bool proven() const { return outcome != UNKNOWN; }
+};
+
+/**
+ * @brief Exact solver for two-player endgames with every card known.
+ *
+ * Plays the engine's standard rules on an EndgamePosition: stacked plays
+ * from MoveList, Skip and Reverse stacks (in two-player games an odd
+ * Reverse stack acts as a Skip, so the same seat plays again), Draw Two
+ * penalties, drawing with and without a playable card, playing a drawn
+ * card, and reshuffling the discard pile when the draw pile runs out.
+ * Draws come from the position's copy of the deck, so, as in a
+ * double-dummy bridge solver, the game has no chance left and each
+ * position is a win or a loss for the seat to move.
+ *
+ * Alpha-beta (negamax over win / unknown / loss) deepens one turn at a
+ * time until the root is proven or the limits in EndgameConfig run out;
+ * a game that can last forever by drawing stays unknown. Positions go in
+ * a TranspositionTable under the Zobrist hash of the position XOR a hash
+ * of the cards the deck will still deal, with the best move for
+ * ordering, so different orders of the same plays are searched once.
+ * Lines that reshuffle the discard pile depend on the order cards were
+ * discarded in and are never stored.
+ *
+ * expected() is the expectimax layer: it averages exact results over
+ * reshuffles of the draw pile, giving each move's winning chance when
+ * the deck order is not known.
+ *
+ * With several threads, every thread searches the same root with the
+ * moves in a different order and they share the table (lazy SMP); the
+ * caller's thread gives the result. Entries stay valid across solves.
+ * One solve at a time per solver.
+ *
+ * @author Tuan
+ */
+class EndgameSolver {
+private:
+    enum Bound { BOUND_UPPER = 1, BOUND_LOWER = 2, BOUND_EXACT = 3 };
+
+    static const int NO_MOVE = 0xFFFF;
+    static const int PROVEN_DEPTH = 255;
+    static const uint64_t NODE_BATCH = 4096;
+
+    /** Table word: outcome, move, bound, depth in the top byte. */
+    struct Entry {
+        int value;
+        int move;
+        int bound;
+        int depth;   // PROVEN_DEPTH for a win or loss, valid at any depth
+
+        static uint64_t pack(int value, int move, int bound, int depth) {
+            return static_cast<uint64_t>(value + 1) | (static_cast<uint64_t>(move & NO_MOVE) << 16) |
+                   (static_cast<uint64_t>(bound) << 32) | (static_cast<uint64_t>(depth) << 56);
+        }
+
+        static Entry unpack(uint64_t data) {
+            Entry e;
+            e.value = static_cast<int>(data & 3) - 1;
+            e.move = static_cast<int>((data >> 16) & NO_MOVE);
+            e.bound = static_cast<int>((data >> 32) & 3);
+            e.depth = static_cast<int>(data >> 56);
+            return e;
+        }
+    };
+
+    /** One thread's search. */
+    struct Search {
+        uint64_t nodes;   // not yet added to the shared count
+        int offset;       // rotation of this thread's move order
+        bool recycled;    // a line below the current node reshuffled the discard pile
+    };
+
+    EndgameConfig config;
+    TranspositionTable table;
+    std::vector<uint64_t> deckKeys;   // deckKeys[i]: hash of the cards left after i draws from the root
+    std::atomic<bool> stopping;
+    std::atomic<uint64_t> nodesUsed;
+
+    // --- Search ---
+
+    void countNode(Search& s) {
+        if (++s.nodes < NODE_BATCH) return;
+        uint64_t used = nodesUsed.fetch_add(s.nodes, std::memory_order_relaxed) + s.nodes;
+        s.nodes = 0;
+        if (config.maxNodes > 0 && used >= config.maxNodes) {
+            stopping.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    /** Hash every suffix of the cards the root's deck will deal before it reshuffles. */
+    void hashDeck(const EndgamePosition& root) {
+        Deck deck = root.deck;
+        int n = deck.size();
+        std::vector<Card> upcoming(n);
+        for (int i = 0; i < n; i++) upcoming[i] = deck.drawFromDeck();
+        deckKeys.assign(n + 1, 0);
+        uint64_t h = 0x6A09E667F3BCC908ULL;
+        deckKeys[n] = ZobristKeys::mix(h);
+        for (int i = n - 1; i >= 0; i--) {
+            h = deckKeys[i + 1] ^ static_cast<uint64_t>(upcoming[i].kind() + 1);
+            deckKeys[i] = ZobristKeys::mix(h);
+        }
+    }
+
+    static bool provenBy(int value, int bound) {
+        return (value == EndgameResult::WIN && bound != BOUND_UPPER) ||
+               (value == EndgameResult::LOSS && bound != BOUND_LOWER);
+    }
+
+    /** The seat to move ends its turn. Value for that seat. */
+    int passValue(EndgamePosition& pos, int alpha, int beta, int depth, Search& s) {
+        pos.setTurn(pos.other());
+        return -turnValue(pos, -beta, -alpha, depth - 1, s);
+    }
+
+    /**
+     * The seat to move has just played count cards of type. Applies the
+     * stacked effect as applyStackedEffects() does with two players.
+     * Value for that seat.
+     */
+    int afterPlay(EndgamePosition& pos, CardType type, int count, int alpha, int beta, int depth, Search& s) {
+        if (pos.hands[pos.turn].isEmpty()) return EndgameResult::WIN;
+        Card drawn;
+        switch (type) {
+            case SKIP:
+                if (count % 2 == 1) return turnValue(pos, alpha, beta, depth - 1, s);
+                break;
+            case REVERSE:
+                // Two players: the reverse and the extra advance bring play back
+                if (count % 2 == 1) {
+                    pos.reverse();
+                    return turnValue(pos, alpha, beta, depth - 1, s);
+                }
+                break;
+            case DRAW_TWO:
+                for (int i = 0; i < 2 * count && pos.draw(pos.other(), drawn); i++) {}
+                return turnValue(pos, alpha, beta, depth - 1, s);
+            case NUMBER:
+                break;
+        }
+        return passValue(pos, alpha, beta, depth, s);
+    }
+
+    /** Value of one move by the seat to move. */
+    int moveValue(const EndgamePosition& pos, const Play& play, int alpha, int beta, int depth, Search& s) {
+        EndgamePosition next = pos;
+        if (play.isDraw()) {
+            // Drawing with a playable card ends the turn; the drawn card is kept
+            Card drawn;
+            next.draw(pos.turn, drawn);
+            return passValue(next, alpha, beta, depth, s);
+        }
+        // Same order as Play::toIndices(): lead, the middle of the stack, top card
+        Card cards[4 * Play::COPY_BITS];
+        int n = 0;
+        const int K = Card::KINDS_PER_COLOR;
+        cards[n++] = play.leadCard();
+        for (int c = 0; c < 4; c++) {
+            int middle = play.copies(c) - (c == play.lead ? 1 : 0) - (c == play.last ? 1 : 0);
+            for (int i = 0; i < middle; i++) cards[n++] = Card::fromKind(c * K + play.rank);
+        }
+        if (play.count > 1) cards[n++] = play.topCard();
+        next.play(cards, n);
+        return afterPlay(next, play.topCard().type(), n, alpha, beta, depth, s);
+    }
+
+    /** Nothing playable: draw a card, then play it or keep it. Value for the drawer. */
+    int forcedDraw(const EndgamePosition& pos, int alpha, int beta, int depth, Search& s) {
+        EndgamePosition next = pos;
+        Card drawn;
+        if (!next.draw(pos.turn, drawn) || !drawn.isPlayable(pos.top)) {
+            return passValue(next, alpha, beta, depth, s);
+        }
+        EndgamePosition played = next;
+        played.play(&drawn, 1);
+        int best = afterPlay(played, drawn.type(), 1, alpha, beta, depth, s);
+        if (best >= beta) return best;
+        int keep = passValue(next, best > alpha ? best : alpha, beta, depth, s);
+        return keep > best ? keep : best;
+    }
+
+    /** Start of a turn for pos.turn. Value for that seat. */
+    int turnValue(const EndgamePosition& pos, int alpha, int beta, int depth, Search& s) {
+        if (pos.recycled) s.recycled = true;
+        if (depth <= 0 || stopping.load(std::memory_order_relaxed)) return EndgameResult::UNKNOWN;
+        countNode(s);
+
+        bool cacheable = !pos.recycled;
+        uint64_t key = cacheable ? pos.hash ^ deckKeys[pos.drawn] : 0;
+        int ttMove = NO_MOVE;
+        uint64_t data;
+        if (cacheable && table.probe(key, data)) {
+            Entry e = Entry::unpack(data);
+            ttMove = e.move;
+            if (e.depth >= depth) {
+                if (e.bound == BOUND_EXACT) return e.value;
+                if (e.bound == BOUND_LOWER && e.value >= beta) return e.value;
+                if (e.bound == BOUND_UPPER && e.value <= alpha) return e.value;
+            }
+        }
+
+        bool recycledAbove = s.recycled;
+        s.recycled = false;
+        int alphaStart = alpha;
+        int best;
+        int bestMove = NO_MOVE;
+        const Hand& hand = pos.hands[pos.turn];
+        if (!hand.hasPlayable(pos.top)) {
+            best = forcedDraw(pos, alpha, beta, depth, s);
+        } else {
+            MoveList moves;
+            moves.generate(hand, pos.top);
+            best = searchMoves(pos, moves, ttMove, alpha, beta, depth, s, bestMove, nullptr);
+        }
+
+        cacheable = cacheable && !s.recycled && !stopping.load(std::memory_order_relaxed);
+        s.recycled = s.recycled || recycledAbove;
+        if (cacheable) {
+            int bound = best <= alphaStart ? BOUND_UPPER : (best >= beta ? BOUND_LOWER : BOUND_EXACT);
+            table.store(key, Entry::pack(best, bestMove, bound, provenBy(best, bound) ? PROVEN_DEPTH : depth));
+        }
+        return best;
+    }
+
+    /**
+     * Max over the moves: the table's move first, then moves that keep the
+     * turn, bigger stacks and drawing last, rotated by the thread's offset.
+     * With values set, every move gets a full window and its value is
+     * written there.
+     */
+    int searchMoves(const EndgamePosition& pos, const MoveList& moves, int ttMove,
+                    int alpha, int beta, int depth, Search& s, int& bestMove, int* values) {
+        int n = moves.size();
+        int handSize = pos.hands[pos.turn].size();
+        if (values == nullptr) {
+            for (int m = 0; m < n; m++) {
+                if (moves[m].count == handSize) {
+                    bestMove = m;
+                    return EndgameResult::WIN;
+                }
+            }
+        }
+
+        int order[MoveList::CAPACITY];
+        int score[MoveList::CAPACITY];
+        int count = 0;
+        for (int m = 0; m < n; m++) {
+            if (m == ttMove) continue;
+            const Play& play = moves[m];
+            CardType type = play.leadCard().type();
+            bool keepsTurn = play.count > 0 && (type == DRAW_TWO ||
+                             ((type == SKIP || type == REVERSE) && play.count % 2 == 1));
+            int sc = play.isDraw() ? -1 : (keepsTurn ? 100 : 0) + play.count;
+            int j = count++;
+            while (j > 0 && score[j - 1] < sc) {
+                order[j] = order[j - 1];
+                score[j] = score[j - 1];
+                j--;
+            }
+            order[j] = m;
+            score[j] = sc;
+        }
+
+        int best = EndgameResult::LOSS - 1;
+        for (int i = -1; i < count; i++) {
+            int m;
+            if (i < 0) {
+                if (ttMove >= n) continue;
+                m = ttMove;
+            } else {
+                m = order[(i + s.offset) % count];
+            }
+            int v = values != nullptr ? moveValue(pos, moves[m], EndgameResult::LOSS - 1, EndgameResult::WIN + 1, depth, s)
+                                      : moveValue(pos, moves[m], alpha, beta, depth, s);
+            if (values != nullptr) values[m] = v;
+            if (v > best) {
+                best = v;
+                bestMove = m;
+            }
+            if (values != nullptr) continue;
+            if (best > alpha) alpha = best;
+            if (alpha >= beta) break;
+        }
+        return best;
+    }
+
+    int rootValue(const EndgamePosition& root, const MoveList& moves, bool decision, uint64_t key,
+                  int alpha, int beta, int depth, Search& s, int& bestMove, int* values) {
+        if (!decision) return forcedDraw(root, alpha, beta, depth, s);
+        int ttMove = NO_MOVE;
+        uint64_t data;
+        if (table.probe(key, data)) ttMove = Entry::unpack(data).move;
+        return searchMoves(root, moves, ttMove, alpha, beta, depth, s, bestMove, values);
+    }
+
+    /**
+     * Deepen from root until proven, out of depth or stopped. values, if
+     * set, receives every root move's outcome. Returns the last completed
+     * depth's result.
+     */
+    EndgameResult deepen(const EndgamePosition& root, Search& s, std::vector<int>* values) {
+        EndgameResult result;
+        MoveList moves;
+        bool decision = root.hands[root.turn].hasPlayable(root.top);
+        if (decision) moves.generate(root.hands[root.turn], root.top);
+        std::vector<int> scratch(decision ? moves.size() : 0);
+        uint64_t key = root.hash ^ deckKeys[0];
+
+        for (int depth = 1; depth <= config.maxDepth; depth++) {
+            s.recycled = false;
+            int bestMove = NO_MOVE;
+            int value;
+            if (values != nullptr) {
+                value = rootValue(root, moves, decision, key, EndgameResult::LOSS - 1, EndgameResult::WIN + 1,
+                                  depth, s, bestMove, scratch.data());
+            } else {
+                // Null windows: is it a win? If not, is it a loss?
+                value = rootValue(root, moves, decision, key, EndgameResult::UNKNOWN, EndgameResult::WIN,
+                                  depth, s, bestMove, nullptr);
+                if (value < EndgameResult::WIN) {
+                    value = rootValue(root, moves, decision, key, EndgameResult::LOSS, EndgameResult::UNKNOWN,
+                                      depth, s, bestMove, nullptr);
+                    if (value > EndgameResult::LOSS) value = EndgameResult::UNKNOWN;
+                }
+            }
+            if (stopping.load(std::memory_order_relaxed)) break;
+
+            result.outcome = value;
+            result.best = bestMove != NO_MOVE ? moves[bestMove] : Play();
+            result.depth = depth;
+            if (values != nullptr) *values = scratch;
+            if (decision && !s.recycled) {
+                table.store(key, Entry::pack(value, bestMove, BOUND_EXACT,
+                                             result.proven() ? PROVEN_DEPTH : depth));
+            }
+            bool done = result.proven();
+            if (values != nullptr && decision) {
+                // Analysis goes on until every move is decided
+                for (int v : scratch) done = done && v != EndgameResult::UNKNOWN;
+            }
+            if (done) break;
+        }
+        return result;
+    }
+
+    void helperLoop(const EndgamePosition* root, int index) {
+        Search s = Search();
+        s.offset = index;
+        deepen(*root, s, nullptr);
+        nodesUsed.fetch_add(s.nodes, std::memory_order_relaxed);
+    }
+
+    EndgameResult run(const EndgamePosition& root, std::vector<int>* values) {
+        hashDeck(root);
+        stopping.store(false, std::memory_order_relaxed);
+        nodesUsed.store(0, std::memory_order_relaxed);
+        std::vector<std::thread> helpers;
+        for (int t = 1; t < config.threads; t++) {
+            helpers.emplace_back(&EndgameSolver::helperLoop, this, &root, t);
+        }
+        Search s = Search();
+        EndgameResult result = deepen(root, s, values);
+        nodesUsed.fetch_add(s.nodes, std::memory_order_relaxed);
+        stopping.store(true, std::memory_order_relaxed);
+        for (std::thread& t : helpers) t.join();
+        result.nodes = nodesUsed.load(std::memory_order_relaxed);
+        return result;
+    }
+
+public:
+    explicit EndgameSolver(const EndgameConfig& config = EndgameConfig())
+        : config(config), table(config.tableBits), stopping(false), nodesUsed(0) {
+        if (this->config.threads < 1) this->config.threads = 1;
+        if (this->config.maxDepth < 1 || this->config.maxDepth >= PROVEN_DEPTH) {
+            std::cerr << "EndgameSolver: maxDepth must be 1-" << PROVEN_DEPTH - 1 << ", using "
+                      << EndgameConfig().maxDepth << std::endl;
+            this->config.maxDepth = EndgameConfig().maxDepth;
+        }
+    }
+
+    EndgameSolver(const EndgameSolver&) = delete;
+    EndgameSolver& operator=(const EndgameSolver&) = delete;
+
+    /** Outcome and a best move for the seat to move, with the deck as it lies. */
+    EndgameResult solve(const EndgamePosition& root) { return run(root, nullptr); }
+
+    /**
+     * Like solve(), and also the outcome of every move in
+     * MoveList::generate() order (empty if the seat to move has nothing
+     * playable), for rating other players' choices.
+     */
+    EndgameResult analyze(const EndgamePosition& root, std::vector<int>& values) {
+        values.clear();
+        return run(root, &values);
+    }
+
+    /**
+     * Winning chance of every move (MoveList::generate() order) when the
+     * draw pile is in random order: the mean over samples reshuffles of
+     * each move's exact outcome, an unknown one counting as half. Returns
+     * the best move's chance; values is empty if nothing is playable.
+     */
+    double expected(const EndgamePosition& root, int samples, uint64_t seed, std::vector<double>& values) {
+        values.clear();
+        double best = 0.0;
+        std::vector<int> outcomes;
+        for (int i = 0; i < samples; i++) {
+            EndgamePosition world = root;
+            world.deck.seed(streamSeed(seed, static_cast<uint64_t>(i)));
+            world.deck.shuffle();
+            EndgameResult r = analyze(world, outcomes);
+            if (outcomes.empty()) {
+                best += (r.outcome + 1) * 0.5;
+                continue;
+            }
+            values.resize(outcomes.size(), 0.0);
+            for (size_t m = 0; m < outcomes.size(); m++) values[m] += (outcomes[m] + 1) * 0.5;
+        }
+        if (samples <= 0) return 0.5;
+        for (double& v : values) {
+            v /= samples;
+            if (v > best) best = v;
+        }
+        return values.empty() ? best / samples : best;
+    }
+
+    /**
+     * After a forced draw of drawn (already in the hand of the seat to
+     * move): true if playing it is at least as good as keeping it.
+     */
+    bool playDrawn(const EndgamePosition& pos, const Card& drawn) {
+        hashDeck(pos);
+        stopping.store(false, std::memory_order_relaxed);
+        nodesUsed.store(0, std::memory_order_relaxed);
+        int play = EndgameResult::UNKNOWN;
+        int keep = EndgameResult::UNKNOWN;
+        for (int depth = 1; depth <= config.maxDepth; depth++) {
+            Search s = Search();
+            EndgamePosition played = pos;
+            played.play(&drawn, 1);
+            int p = afterPlay(played, drawn.type(), 1, EndgameResult::LOSS - 1, EndgameResult::WIN + 1, depth, s);
+            EndgamePosition kept = pos;
+            int k = passValue(kept, EndgameResult::LOSS - 1, EndgameResult::WIN + 1, depth, s);
+            if (stopping.load(std::memory_order_relaxed)) break;
+            play = p;
+            keep = k;
+            if (play == EndgameResult::WIN || (play != EndgameResult::UNKNOWN && keep != EndgameResult::UNKNOWN)) break;
+        }
+        return play >= keep;
+    }
+
+    /** Forget every stored position. */
+    void clear() { table.clear(); }
+
+    const EndgameConfig& getConfig() const { return config; }
+    size_t tableBytes() const { return table.memoryBytes(); }
+};
+
+/**
+ * @brief Plays perfectly once both hands are small: the endgame oracle.
+ *
+ * In two-player games where both hands hold at most maxCards cards, every
+ * decision comes from an EndgameSolver; before that (and at bigger
+ * tables) from the fallback policy, by default a GreedyPolicy. With
+ * samples == 0 it solves the deck as it lies, so it knows the cards to
+ * come; otherwise it picks the move with the best expected() chance.
+ *
+ * @author Tuan
+ */
+class EndgamePolicy : public PlayerPolicy {
+private:
+    EndgameSolver solver;
+    GreedyPolicy greedy;
+    PlayerPolicy* fallback;
+    EndgamePosition position;
+    int maxCards;
+    int samples;
+    uint64_t seed;
+    uint64_t decisions;
+
+    bool inEndgame(const GameState& state) {
+        if (state.numPlayers != EndgamePosition::SEATS || state.penalty != 0) return false;
+        for (int s = 0; s < state.numPlayers; s++) {
+            if (state.players[s].handSize() > maxCards) return false;
+        }
+        return position.load(state);
+    }
+
+public:
+    /** fallback is not owned; nullptr plays greedily until the endgame. */
+    explicit EndgamePolicy(int maxCards = 6, int samples = 0, PlayerPolicy* fallback = nullptr,
+                           const EndgameConfig& config = EndgameConfig())
+        : solver(config), fallback(fallback != nullptr ? fallback : &greedy),
+          maxCards(maxCards), samples(samples), seed(0), decisions(0) {}
+
+    void newGame(uint64_t gameSeed) override {
+        seed = gameSeed;
+        fallback->newGame(gameSeed);
+    }
+
+    void chooseCards(const GameState& state, int seat, std::vector<int>& indices) override {
+        if (!inEndgame(state)) {
+            fallback->chooseCards(state, seat, indices);
+            return;
+        }
+        indices.clear();
+        const Hand& hand = state.players[seat].hand;
+        if (samples <= 0) {
+            solver.solve(position).best.toIndices(hand, indices);
+            return;
+        }
+        std::vector<double> values;
+        solver.expected(position, samples, streamSeed(seed, ++decisions), values);
+        MoveList moves;
+        moves.generate(hand, state.topCard);
+        size_t best = 0;
+        for (size_t m = 1; m < values.size(); m++) {
+            if (values[m] > values[best]) best = m;
+        }
+        if (!values.empty()) moves[static_cast<int>(best)].toIndices(hand, indices);
+    }
+
+    bool playDrawnCard(const GameState& state, int seat, const Card& drawn) override {
+        if (!inEndgame(state)) return fallback->playDrawnCard(state, seat, drawn);
+        return solver.playDrawn(position, drawn);
+    }
+
+    EndgameSolver& getSolver() { return solver; }
+};
+
+#endif // ENDGAMESOLVER_H
@@ -0,0 +1,109 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include "Card.h"
+#include "GameObserver.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Kinds of events recorded by EventLog.
+ * @author Tuan
+ */
+enum GameEventType : uint8_t {
+    EVENT_GAME_START,
+    EVENT_TURN_START,
+    EVENT_FORCED_DRAW,
+    EVENT_CARD_DRAWN,
+    EVENT_DECK_EMPTY,
+    EVENT_CARD_PLAYED,    // one per card; stacked plays give several in a row
+    EVENT_EFFECT,
+    EVENT_UNO,
+    EVENT_WINNER,
+    EVENT_DRAW
+};
+
+/**
+ * @brief One fixed-size record of something that happened in a game.
+ *
+ * Field use by type: seat is the acting seat (the victim for a Draw Two
+ * effect, -1 when nobody acts); card is the card drawn or played (the
+ * top card for EVENT_GAME_START); count is the stack size for an effect;
+ * drawn is the number of penalty cards for a Draw Two effect.
+ *
+ * @author Tuan
+ */
+struct GameEvent {
+    GameEventType type;
+    int8_t count;
+    int16_t seat;
+    int16_t drawn;
+    Card card;
+};
+
+/**
+ * @brief Observer that appends every event to an in-memory vector.
+ *
+ * No strings are built. The vector keeps its capacity across clear(),
+ * so recording games back to back does not allocate once warmed up.
+ *
+ * @author Tuan
+ */
+class EventLog {
+private:
+    std::vector<GameEvent> log;
+
+    void push(GameEventType type, int seat, Card card = Card(), int count = 0, int drawn = 0) {
+        GameEvent e;
+        e.type = type;
+        e.count = static_cast<int8_t>(count);
+        e.seat = static_cast<int16_t>(seat);
+        e.drawn = static_cast<int16_t>(drawn);
+        e.card = card;
+        log.push_back(e);
+    }
+
+public:
+    const std::vector<GameEvent>& events() const { return log; }
+    void clear() { log.clear(); }
+
+    template <typename Game>
+    void onGameStart(const Game& game) {
+        clear();
+        push(EVENT_GAME_START, -1, game.topCard());
+    }
+
+    template <typename Game>
+    void onTurnStart(const Game&, int seat) { push(EVENT_TURN_START, seat); }
+
+    template <typename Game>
+    void onForcedDraw(const Game&, int seat) { push(EVENT_FORCED_DRAW, seat); }
+
+    template <typename Game>
+    void onCardDrawn(const Game&, int seat, Card card) { push(EVENT_CARD_DRAWN, seat, card); }
+
+    template <typename Game>
+    void onDeckEmpty(const Game&, int seat) { push(EVENT_DECK_EMPTY, seat); }
+
+    template <typename Game>
+    void onCardsPlayed(const Game&, int seat, const Card* cards, int count) {
+        for (int i = 0; i < count; i++) push(EVENT_CARD_PLAYED, seat, cards[i]);
+    }
+
+    template <typename Game>
+    void onEffect(const Game&, CardType type, int count, int target, int drawn) {
+        Card card(RED, -1, type);   // color is not meaningful here
+        push(EVENT_EFFECT, target, card, count, drawn);
+    }
+
+    template <typename Game>
+    void onUno(const Game&, int seat) { push(EVENT_UNO, seat); }
+
+    template <typename Game>
+    void onWinner(const Game&, int seat) { push(EVENT_WINNER, seat); }
+
+    template <typename Game>
+    void onDraw(const Game&) { push(EVENT_DRAW, -1); }
+};
+
+#endif // EVENTLOG_H
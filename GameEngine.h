@@ -0,0 +1,561 @@
+#ifndef GAMEENGINE_H
+#define GAMEENGINE_H
+
+#include "GameObserver.h"
+#include "GameState.h"
+#include "Instrument.h"
+#include "PlayerPolicy.h"
+#include "Random.h"
+#include "Rules.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/**
+ * @brief Outcome of a finished game.
+ * @author Tuan
+ */
+struct GameResult {
+    int winner;   // seat index of the winner, -1 for a draw (turn limit hit)
+    int turns;    // number of turns played
+
+    bool isDraw() const { return winner < 0; }
+};
+
+/**
+ * @brief Decision the engine is waiting for from the current seat.
+ * @author Tuan
+ */
+enum TurnDecision {
+    DECIDE_NONE,         // no decision pending
+    DECIDE_CARDS,        // choose cards to play (or draw)
+    DECIDE_PLAY_DRAWN    // play the card just drawn or keep it
+};
+
+/**
+ * @brief Headless UNO-Lite rules engine.
+ *
+ * Plays the rules on a GameState (deck, hands, turn order as a TurnRing
+ * of seat indices) and asks each seat's PlayerPolicy for its decisions,
+ * so a game can run without a terminal. The state is a flat value:
+ * state() and restore() snapshot and rewind a game in one copy.
+ *
+ * Everything that happens is reported to the Observer as a typed event
+ * (see GameObserver.h). The engine itself never formats text; the
+ * default NullObserver compiles every event away.
+ *
+ * The house rules come from a rules class (see Rules.h). Each rule is a
+ * compile-time constant tested with `if constexpr`, so the standard
+ * engine carries no code for the variants it does not play.
+ *
+ * @tparam Observer Receives game events, e.g. TerminalRenderer or EventLog.
+ * @tparam Rules    Hand size, deck and rule switches, e.g. NoStackingRules.
+ * @author Tuan
+ */
+template <typename Observer = NullObserver, typename Rules = StandardRules>
+class BasicGameEngine {
+public:
+    typedef Rules RulesType;
+
+    static constexpr int INITIAL_HAND_SIZE = Rules::HAND_SIZE;
+    static constexpr int MIN_PLAYERS = Rules::MIN_PLAYERS;
+    static constexpr int MAX_PLAYERS = Rules::MAX_PLAYERS;
+    static constexpr int DRAW_TWO_PENALTY = Rules::DRAW_TWO_PENALTY;
+    static constexpr int DEFAULT_MAX_TURNS = 10000;
+
+    static_assert(cardsInDeck<Rules>() <= Deck::CAPACITY, "deck does not fit in a Deck");
+    static_assert(MAX_PLAYERS <= GameState::MAX_PLAYERS, "GameState has too few seats");
+    static_assert(MAX_PLAYERS * INITIAL_HAND_SIZE < cardsInDeck<Rules>(), "not enough cards to deal");
+
+private:
+    GameState game;
+    std::vector<std::string> names;
+    std::vector<PlayerPolicy*> policies;
+    std::vector<Card> playedCards;    // scratch buffers reused every turn
+    std::vector<int> removalOrder;
+    std::vector<int> choice;          // the current policy's answer
+    std::vector<int> leadOnly;        // the lead of a selection when stacking is off
+    Observer observer;
+    TurnDecision pending;   // decision the current seat owes, if any
+    Card pendingCard;       // the drawn card while pending == DECIDE_PLAY_DRAWN
+    int maxTurns;
+
+    // --- Setup helpers ---
+
+    void dealCards() {
+        for (int i = 0; i < game.numPlayers; i++) {
+            for (int j = 0; j < INITIAL_HAND_SIZE; j++) {
+                if (!game.deck.isEmpty()) {
+                    game.players[i].drawCard(game.deck.drawFromDeck());
+                }
+            }
+        }
+    }
+
+    void flipFirstCard() {
+        game.topCard = game.deck.drawFromDeck();
+        // If first card is an action card, put it back and reshuffle
+        while (game.topCard.type() != NUMBER) {
+            game.deck.addCard(game.topCard);
+            game.deck.shuffle();
+            game.topCard = game.deck.drawFromDeck();
+        }
+        observer.onGameStart(*this);
+    }
+
+    // --- Core game logic helpers ---
+
+    bool checkWinner(Player& player) {
+        if (player.handSize() == 0) {
+            observer.onWinner(*this, player.seat);
+            game.winner = player.seat;
+            game.over = true;
+            return true;
+        }
+        return false;
+    }
+
+    void announceUno(const Player& player) {
+        if (player.handSize() == 1) {
+            observer.onUno(*this, player.seat);
+        }
+    }
+
+    bool drawFromDeckIfPossible(Player& player, Card& drawn) {
+        if (game.deck.isEmpty()) {
+            observer.onDeckEmpty(*this, player.seat);
+            return false;
+        }
+        drawn = game.deck.drawFromDeck();
+        observer.onCardDrawn(*this, player.seat, drawn);
+        player.drawCard(drawn);
+        return true;
+    }
+
+    // The victim of count stacked Draw Twos draws the penalty
+    void drawPenalty(Player& victim, int count) {
+        int totalDraw = DRAW_TWO_PENALTY * count;
+        int drawn = 0;
+        for (int i = 0; i < totalDraw; i++) {
+            if (!game.deck.isEmpty()) {
+                victim.drawCard(game.deck.drawFromDeck());
+                drawn++;
+            }
+        }
+        UNO_COUNT_BY(PENALTY_DRAWS, drawn);
+        observer.onEffect(*this, DRAW_TWO, count, victim.seat, drawn);
+    }
+
+    // Penalty stacking: the current seat gives up and draws what it owes
+    void payPenalty(Player& victim) {
+        int count = game.penalty / DRAW_TWO_PENALTY;
+        game.penalty = 0;
+        drawPenalty(victim, count);
+    }
+
+    // Apply stacked card effects. Accounts for gameLoop's advance() after the turn:
+    //   SKIP:     advance N times -> gameLoop advance skips past N players
+    //   REVERSE:  odd count flips direction, even cancels out
+    //   DRAW_TWO: next player draws 2*N and loses their turn (with penalty
+    //             stacking the 2*N is owed instead; see beginTurn)
+    void applyStackedEffects(CardType type, int count) {
+        UNO_TIMED(TIMER_EFFECTS);
+        switch (type) {
+            case SKIP:
+                observer.onEffect(*this, type, count, -1, 0);
+                game.order.skip(count);
+                break;
+
+            case REVERSE:
+                observer.onEffect(*this, type, count, -1, 0);
+                if (count % 2 == 1) {
+                    game.order.reverse();
+                    if (game.numPlayers == 2) {
+                        game.order.advance();
+                    }
+                }
+                break;
+
+            case DRAW_TWO:
+                if constexpr (Rules::PENALTY_STACKING) {
+                    game.penalty += DRAW_TWO_PENALTY * count;
+                } else {
+                    game.order.advance();
+                    drawPenalty(game.players[game.order.current()], count);
+                }
+                break;
+
+            case NUMBER:
+                break;
+        }
+    }
+
+    // Decision point: ask the seat's policy (into a buffer reused every turn)
+    const std::vector<int>& askCards(int seat) {
+        UNO_TIMED(TIMER_DECISION);
+        UNO_COUNT(DECISIONS);
+        policies[seat]->chooseCards(game, seat, choice);
+        return choice;
+    }
+
+    bool askPlayDrawn(int seat) {
+        UNO_TIMED(TIMER_DECISION);
+        UNO_COUNT(DECISIONS);
+        return policies[seat]->playDrawnCard(game, seat, pendingCard);
+    }
+
+    /** End the current turn and pass play on unless the game is over. */
+    void finishTurn() {
+        pending = DECIDE_NONE;
+        if (!game.over) game.order.advance();
+    }
+
+public:
+    BasicGameEngine() : pending(DECIDE_NONE), maxTurns(DEFAULT_MAX_TURNS) {}
+
+    BasicGameEngine(const BasicGameEngine&) = delete;
+    BasicGameEngine& operator=(const BasicGameEngine&) = delete;
+
+    /**
+     * Check a card selection against the stacking rules: indices in range and
+     * unique, first card playable on topCard, the rest stackable with it.
+     * The reason for a rejection is written to out when it is set.
+     */
+    static bool isValidSelection(const Player& player, const std::vector<int>& indices,
+                                 const Card& topCard, std::ostream* out) {
+        if (indices.empty()) return false;
+
+        // Validate all indices are in range
+        for (int idx : indices) {
+            if (idx < 0 || idx >= player.handSize()) {
+                if (out) *out << "Invalid index: " << idx << ". Try again." << std::endl;
+                return false;
+            }
+        }
+
+        // Check for duplicate indices (pairwise: selections are a handful of cards)
+        int duplicate = -1;
+        for (size_t i = 0; i < indices.size(); i++) {
+            for (size_t j = i + 1; j < indices.size(); j++) {
+                if (indices[i] == indices[j] && (duplicate < 0 || indices[i] < duplicate)) {
+                    duplicate = indices[i];
+                }
+            }
+        }
+        if (duplicate >= 0) {
+            if (out) *out << "Duplicate index: " << duplicate << ". Try again." << std::endl;
+            return false;
+        }
+
+        // First card must be playable on the top card
+        Card first = player.hand.get(indices[0]);
+        if (!first.isPlayable(topCard)) {
+            if (out) *out << first << " cannot be played on "
+                          << topCard << ". Try again." << std::endl;
+            return false;
+        }
+
+        // Remaining cards must match the first for stacking
+        for (size_t i = 1; i < indices.size(); i++) {
+            Card card = player.hand.get(indices[i]);
+            if (!card.matchesForStacking(first)) {
+                if (out) *out << card << " does not match "
+                              << first << " for stacking. Try again." << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Seat a player. The policy is not owned and must outlive the engine. It
+     * may be null for a seat whose turns are answered through answerCards().
+     */
+    void addPlayer(const std::string& name, PlayerPolicy* policy) {
+        if (game.numPlayers >= MAX_PLAYERS) {
+            std::cerr << "addPlayer: table is full" << std::endl;
+            return;
+        }
+        names.push_back(name);
+        policies.push_back(policy);
+        game.numPlayers++;
+    }
+
+    /** Replace the policy of a seated player (e.g. rollout bots in a search copy). */
+    void setPolicy(int seat, PlayerPolicy* policy) {
+        if (seat < 0 || seat >= game.numPlayers) {
+            std::cerr << "setPolicy: no seat " << seat << std::endl;
+            return;
+        }
+        policies[seat] = policy;
+    }
+
+    /** The observer that receives this engine's events. */
+    Observer& getObserver() { return observer; }
+    const Observer& getObserver() const { return observer; }
+
+    /** End a game as a draw after this many turns (0 = no limit). */
+    void setMaxTurns(int limit) { maxTurns = limit; }
+
+    /**
+     * Reset hands and turn order, then build, shuffle and deal a new deck.
+     * With fewer than MIN_PLAYERS seats nothing is dealt and the game is
+     * over at once, with no winner.
+     */
+    void start(uint64_t seed) {
+        game.deck.seed(seed);
+        game.order.reset(game.numPlayers);
+        for (int seat = 0; seat < game.numPlayers; seat++) {
+            game.players[seat].hand.clear();
+            if (policies[seat] != nullptr) {
+                policies[seat]->newGame(streamSeed(seed, static_cast<uint64_t>(seat) + 1));
+            }
+        }
+        game.winner = -1;
+        game.turnCount = 0;
+        game.penalty = 0;
+        game.over = false;
+        pending = DECIDE_NONE;
+        if (game.numPlayers < MIN_PLAYERS) {
+            std::cerr << "start: " << game.numPlayers << " players, need at least " << MIN_PLAYERS << std::endl;
+            game.over = true;
+            return;
+        }
+
+        game.deck.build(Rules::MAX_NUMBER, Rules::ZERO_COPIES, Rules::NUMBER_COPIES, Rules::ACTION_COPIES);
+        game.deck.shuffle();
+        dealCards();
+        flipFirstCard();
+    }
+
+    // --- Turn state machine ---
+    //
+    // beginTurn() runs the current seat's turn up to its first decision;
+    // answerCards() / answerPlayDrawn() supply it and finish the turn.
+    // step() drives them with the seats' policies; a server or a coroutine
+    // can instead wait for the answer as long as it likes.
+
+    /**
+     * Start the current seat's turn and return the decision it needs. A turn
+     * that needs none (a forced draw of an unplayable card) is finished
+     * here and DECIDE_NONE is returned; so it is when the game is over or
+     * the turn limit ends it as a draw. While a decision is pending this
+     * returns it again.
+     *
+     * With penalty stacking, a seat that owes a penalty and holds no Draw
+     * Two pays it here and loses its turn, which (as under the standard
+     * rules) is not counted as a turn.
+     */
+    TurnDecision beginTurn() {
+        if (pending != DECIDE_NONE || game.over) return pending;
+        if (maxTurns > 0 && game.turnCount >= maxTurns) {
+            game.over = true;
+            observer.onDraw(*this);
+            return DECIDE_NONE;
+        }
+
+        Player& current = game.players[game.order.current()];
+        if constexpr (Rules::PENALTY_STACKING) {
+            if (game.penalty > 0 && current.hand.stackKinds(Card(RED, -1, DRAW_TWO)) == 0) {
+                payPenalty(current);
+                finishTurn();
+                return DECIDE_NONE;
+            }
+        }
+        game.turnCount++;
+        UNO_COUNT(TURNS);
+        observer.onTurnStart(*this, current.seat);
+
+        if (current.hasPlayableCard(game.topCard)) {
+            pending = DECIDE_CARDS;
+            return pending;
+        }
+
+        UNO_COUNT(FORCED_DRAWS);
+        observer.onForcedDraw(*this, current.seat);
+        Card drawn;
+        bool drew = drawFromDeckIfPossible(current, drawn);
+        if constexpr (Rules::DRAW_UNTIL_PLAYABLE) {
+            while (drew && !drawn.isPlayable(game.topCard)) {
+                drew = drawFromDeckIfPossible(current, drawn);
+            }
+        }
+        if (drew && drawn.isPlayable(game.topCard)) {
+            pendingCard = drawn;
+            pending = DECIDE_PLAY_DRAWN;
+            return pending;
+        }
+        finishTurn();
+        return DECIDE_NONE;
+    }
+
+    /**
+     * Answer DECIDE_CARDS with hand indices, lead first (empty = draw). An
+     * invalid selection counts as a draw. Returns false if the selection
+     * was not played.
+     *
+     * Without stacking only the lead is played. With penalty stacking, a
+     * seat that owes a penalty must lead a Draw Two; anything else pays it.
+     */
+    bool answerCards(const std::vector<int>& indices) {
+        if (pending != DECIDE_CARDS) {
+            std::cerr << "answerCards: no card choice is pending" << std::endl;
+            return false;
+        }
+        if constexpr (!Rules::STACKING) {
+            if (indices.size() > 1) {
+                leadOnly.assign(1, indices[0]);
+                return answerCards(leadOnly);
+            }
+        }
+        Player& current = game.players[game.order.current()];
+        bool valid = isValidSelection(current, indices, game.topCard, nullptr);
+
+        if constexpr (Rules::PENALTY_STACKING) {
+            if (game.penalty > 0 && !(valid && current.hand.get(indices[0]).type() == DRAW_TWO)) {
+                payPenalty(current);
+                finishTurn();
+                return false;
+            }
+        }
+
+        if (!valid) {
+            Card drawn;
+            drawFromDeckIfPossible(current, drawn);
+            finishTurn();
+            return false;
+        }
+
+        // Collect cards before removing (indices shift on removal)
+        std::vector<Card>& cards = playedCards;
+        cards.clear();
+        for (int idx : indices) {
+            cards.push_back(current.hand.get(idx));
+        }
+
+        // Remove from highest index first to keep lower indices valid
+        std::vector<int>& sortedDesc = removalOrder;
+        sortedDesc.assign(indices.begin(), indices.end());
+        std::sort(sortedDesc.rbegin(), sortedDesc.rend());
+        for (int idx : sortedDesc) {
+            current.playCard(idx);
+        }
+
+        // Last card's color becomes the new top card; the rest are discarded
+        game.deck.discard(game.topCard);
+        for (size_t i = 0; i + 1 < cards.size(); i++) {
+            game.deck.discard(cards[i]);
+        }
+        game.topCard = cards.back();
+
+        UNO_STACK(static_cast<int>(cards.size()));
+        observer.onCardsPlayed(*this, current.seat, cards.data(), static_cast<int>(cards.size()));
+
+        announceUno(current);
+        if (!checkWinner(current)) {
+            applyStackedEffects(cards[0].type(), static_cast<int>(cards.size()));
+        }
+        finishTurn();
+        return true;
+    }
+
+    /** Answer DECIDE_PLAY_DRAWN: play the drawn card or keep it. */
+    void answerPlayDrawn(bool play) {
+        if (pending != DECIDE_PLAY_DRAWN) {
+            std::cerr << "answerPlayDrawn: no drawn card is pending" << std::endl;
+            return;
+        }
+        Player& player = game.players[game.order.current()];
+        Card drawn = pendingCard;
+        if (play) {
+            player.hand.remove(drawn);
+            game.deck.discard(game.topCard);
+            game.topCard = drawn;
+            UNO_STACK(1);
+            observer.onCardsPlayed(*this, player.seat, &drawn, 1);
+
+            announceUno(player);
+            if (!checkWinner(player)) {
+                applyStackedEffects(drawn.type(), 1);
+            }
+        }
+        finishTurn();
+    }
+
+    /** Decision the current seat owes, or DECIDE_NONE between turns. */
+    TurnDecision pendingDecision() const { return pending; }
+
+    /** The card drawn while DECIDE_PLAY_DRAWN is pending. */
+    Card drawnCard() const { return pendingCard; }
+
+    /** Play one turn with the seat's policy. Returns false once the game is over. */
+    bool step() {
+        UNO_TIMED(TIMER_TURN);
+        int seat = game.order.current();
+        switch (beginTurn()) {
+            case DECIDE_CARDS:
+                answerCards(askCards(seat));
+                break;
+            case DECIDE_PLAY_DRAWN:
+                answerPlayDrawn(askPlayDrawn(seat));
+                break;
+            case DECIDE_NONE:
+                break;
+        }
+        return !game.over;
+    }
+
+    void gameLoop() {
+        while (step()) {}
+    }
+
+    /** Play a whole game from a fresh deal without any interaction. */
+    GameResult runToCompletion(uint64_t seed) {
+        start(seed);
+        gameLoop();
+        return result();
+    }
+
+    // --- Snapshots ---
+
+    /** The whole position; copy it to take a snapshot. */
+    const GameState& state() const { return game; }
+
+    /**
+     * Continue from a snapshot, typically one taken from an engine with the
+     * same seats. Policies are not told (no newGame call), and the seat
+     * count must match the players added to this engine.
+     */
+    void restore(const GameState& snapshot) {
+        if (snapshot.numPlayers != game.numPlayers) {
+            std::cerr << "restore: snapshot has " << snapshot.numPlayers
+                      << " players, engine has " << game.numPlayers << std::endl;
+            return;
+        }
+        game = snapshot;
+        pending = DECIDE_NONE;
+    }
+
+    /** Result so far: winner is -1 while the game is running or after a draw. */
+    GameResult result() const { return GameResult{ game.winner, game.turnCount }; }
+
+    bool isOver() const { return game.over; }
+    int winner() const { return game.winner; }
+    int turns() const { return game.turnCount; }
+    int playerCount() const { return game.numPlayers; }
+    const Card& topCard() const { return game.topCard; }
+    int currentSeat() const { return game.order.current(); }
+    const Player& player(int seat) const { return game.players[seat]; }
+    const std::string& playerName(int seat) const { return names[seat]; }
+    int deckSize() const { return game.deck.size(); }
+    int discardSize() const { return game.deck.discardSize(); }
+    /** Copies of a card kind in this rules variant's full deck. */
+    int copiesOf(int kind) const { return game.deck.copiesOf(kind); }
+};
+
+/** Silent engine for bots and simulation. */
+using GameEngine = BasicGameEngine<NullObserver>;
+
+#endif // GAMEENGINE_H
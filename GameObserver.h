@@ -0,0 +1,122 @@
+#ifndef GAMEOBSERVER_H
+#define GAMEOBSERVER_H
+
+#include "Card.h"
+
+/**
+ * @brief Observer that ignores every event.
+ *
+ * This is the default observer of BasicGameEngine and also documents the
+ * hook set. The engine is a template on its observer and calls these
+ * hooks directly, so with NullObserver every call inlines to nothing and
+ * a headless game builds no strings and does no I/O.
+ *
+ * Each hook gets the engine as `game` so renderers can read whatever
+ * state they need (top card, hands, seat names) when they need it.
+ *
+ * @author Tuan
+ */
+struct NullObserver {
+    /** Cards are dealt and the first card is flipped. */
+    template <typename Game> void onGameStart(const Game&) {}
+
+    /** Seat is about to play. */
+    template <typename Game> void onTurnStart(const Game&, int) {}
+
+    /** Seat has no playable card and must draw. */
+    template <typename Game> void onForcedDraw(const Game&, int) {}
+
+    /** Seat drew one card on its turn. */
+    template <typename Game> void onCardDrawn(const Game&, int, Card) {}
+
+    /** Seat wanted to draw but both piles are empty. */
+    template <typename Game> void onDeckEmpty(const Game&, int) {}
+
+    /** Seat played count cards (lead first); the last is the new top card. */
+    template <typename Game> void onCardsPlayed(const Game&, int, const Card*, int) {}
+
+    /**
+     * A stack of count action cards took effect. For Draw Two, target is
+     * the victim and drawn the number of cards actually drawn; otherwise
+     * target is -1 and drawn is 0. With penalty stacking a Draw Two takes
+     * effect when the penalty is finally paid, with count the Draw Twos
+     * passed along.
+     */
+    template <typename Game> void onEffect(const Game&, CardType, int, int, int) {}
+
+    /** Seat is down to one card. */
+    template <typename Game> void onUno(const Game&, int) {}
+
+    /**
+     * Seat emptied its hand and left the table, finishing in place
+     * (1 = first out); play goes on without it. Only LargeTable sends this.
+     */
+    template <typename Game> void onSeatOut(const Game&, int, int) {}
+
+    /** Seat emptied its hand and won. */
+    template <typename Game> void onWinner(const Game&, int) {}
+
+    /** The turn limit was reached and the game ended as a draw. */
+    template <typename Game> void onDraw(const Game&) {}
+};
+
+/**
+ * @brief Observer that passes every event to two others, first then second.
+ *
+ * Lets one engine feed, say, a TerminalRenderer and a BeliefTracker. Nest
+ * pairs for more than two.
+ *
+ * @author Tuan
+ */
+template <typename First, typename Second>
+struct ObserverPair {
+    First first;
+    Second second;
+
+    template <typename Game> void onGameStart(const Game& g) {
+        first.onGameStart(g);
+        second.onGameStart(g);
+    }
+    template <typename Game> void onTurnStart(const Game& g, int seat) {
+        first.onTurnStart(g, seat);
+        second.onTurnStart(g, seat);
+    }
+    template <typename Game> void onForcedDraw(const Game& g, int seat) {
+        first.onForcedDraw(g, seat);
+        second.onForcedDraw(g, seat);
+    }
+    template <typename Game> void onCardDrawn(const Game& g, int seat, Card card) {
+        first.onCardDrawn(g, seat, card);
+        second.onCardDrawn(g, seat, card);
+    }
+    template <typename Game> void onDeckEmpty(const Game& g, int seat) {
+        first.onDeckEmpty(g, seat);
+        second.onDeckEmpty(g, seat);
+    }
+    template <typename Game> void onCardsPlayed(const Game& g, int seat, const Card* cards, int count) {
+        first.onCardsPlayed(g, seat, cards, count);
+        second.onCardsPlayed(g, seat, cards, count);
+    }
+    template <typename Game> void onEffect(const Game& g, CardType type, int count, int target, int drawn) {
+        first.onEffect(g, type, count, target, drawn);
+        second.onEffect(g, type, count, target, drawn);
+    }
+    template <typename Game> void onUno(const Game& g, int seat) {
+        first.onUno(g, seat);
+        second.onUno(g, seat);
+    }
+    template <typename Game> void onSeatOut(const Game& g, int seat, int place) {
+        first.onSeatOut(g, seat, place);
+        second.onSeatOut(g, seat, place);
+    }
+    template <typename Game> void onWinner(const Game& g, int seat) {
+        first.onWinner(g, seat);
+        second.onWinner(g, seat);
+    }
+    template <typename Game> void onDraw(const Game& g) {
+        first.onDraw(g);
+        second.onDraw(g);
+    }
+};
+
+#endif // GAMEOBSERVER_H
@@ -0,0 +1,334 @@
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include "GameEngine.h"
+#include "GameState.h"
+#include "PlayerPolicy.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Compact binary game records.
+ *
+ * A game is fully determined by its seed and the decisions its players
+ * made, so that is all a record stores. File layout:
+ *
+ *   file    = "UNOR" version:u8 record*
+ *   record  = varint(payload length) payload
+ *   payload = seed:u64le players:u8 varint(maxTurns) varint(winner + 1)
+ *             varint(turns) decision*
+ *
+ * Decisions appear in the order the engine asked for them:
+ *   chooseCards   -> varint(n) [varint(first index) zigzag-varint(delta)*(n-1)]
+ *                    (n = 0 means draw)
+ *   playDrawnCard -> u8 0 or 1
+ *
+ * A typical turn costs two bytes.
+ *
+ * @author Tuan
+ */
+
+inline constexpr char GAME_RECORD_MAGIC[4] = { 'U', 'N', 'O', 'R' };
+inline constexpr uint8_t GAME_RECORD_VERSION = 1;
+
+inline void putVarint(std::vector<uint8_t>& buf, uint64_t value) {
+    while (value >= 0x80) {
+        buf.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buf.push_back(static_cast<uint8_t>(value));
+}
+
+/** Read a varint at p (not past end). Returns false on truncated input. */
+inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+inline uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+inline int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+/**
+ * @brief Wraps a policy and appends each of its decisions to a shared buffer.
+ *
+ * Give every seat a RecordingPolicy pointing at the same buffer so the
+ * decisions land in the order the engine asked for them.
+ *
+ * @author Tuan
+ */
+class RecordingPolicy : public PlayerPolicy {
+private:
+    PlayerPolicy* inner;
+    std::vector<uint8_t>* decisions;
+
+public:
+    RecordingPolicy(PlayerPolicy* inner, std::vector<uint8_t>* decisions)
+        : inner(inner), decisions(decisions) {}
+
+    void newGame(uint64_t seed) override { inner->newGame(seed); }
+
+    void chooseCards(const GameState& state, int seat, std::vector<int>& indices) override {
+        inner->chooseCards(state, seat, indices);
+        putVarint(*decisions, indices.size());
+        for (size_t i = 0; i < indices.size(); i++) {
+            if (i == 0) putVarint(*decisions, static_cast<uint64_t>(indices[0]));
+            else putVarint(*decisions, zigzag(static_cast<int64_t>(indices[i]) - indices[i - 1]));
+        }
+    }
+
+    bool playDrawnCard(const GameState& state, int seat, const Card& drawn) override {
+        bool play = inner->playDrawnCard(state, seat, drawn);
+        decisions->push_back(play ? 1 : 0);
+        return play;
+    }
+};
+
+/**
+ * @brief Policy that answers from a recorded decision stream.
+ *
+ * One instance can serve every seat. If the stream runs out or is
+ * malformed, it draws and sets failed().
+ *
+ * @author Tuan
+ */
+class ReplayPolicy : public PlayerPolicy {
+private:
+    const uint8_t* p;
+    const uint8_t* end;
+    bool error;
+
+public:
+    ReplayPolicy() : p(nullptr), end(nullptr), error(false) {}
+
+    void load(const uint8_t* data, size_t size) {
+        p = data;
+        end = data + size;
+        error = false;
+    }
+
+    bool failed() const { return error; }
+    bool finished() const { return p == end; }
+
+    void chooseCards(const GameState&, int, std::vector<int>& indices) override {
+        indices.clear();
+        uint64_t n, v;
+        if (!getVarint(p, end, n)) { error = true; return; }
+        for (uint64_t i = 0; i < n; i++) {
+            if (!getVarint(p, end, v)) { error = true; indices.clear(); return; }
+            if (i == 0) indices.push_back(static_cast<int>(v));
+            else indices.push_back(indices.back() + static_cast<int>(unzigzag(v)));
+        }
+    }
+
+    bool playDrawnCard(const GameState&, int, const Card&) override {
+        if (p >= end) { error = true; return false; }
+        return *p++ != 0;
+    }
+};
+
+/**
+ * @brief Header fields of one record plus a pointer to its decisions.
+ *
+ * decisions points into the reader's mapping; nothing is copied.
+ */
+struct GameRecordView {
+    uint64_t seed;
+    int players;
+    int maxTurns;
+    int winner;
+    int turns;
+    const uint8_t* decisions;
+    size_t decisionBytes;
+};
+
+/** Append one record (header + decisions) to out. */
+inline void encodeGameRecord(std::vector<uint8_t>& out, std::vector<uint8_t>& scratch,
+                             uint64_t seed, int players, int maxTurns, int winner, int turns,
+                             const std::vector<uint8_t>& decisions) {
+    scratch.clear();
+    for (int i = 0; i < 8; i++) scratch.push_back(static_cast<uint8_t>(seed >> (8 * i)));
+    scratch.push_back(static_cast<uint8_t>(players));
+    putVarint(scratch, static_cast<uint64_t>(maxTurns));
+    putVarint(scratch, static_cast<uint64_t>(winner + 1));
+    putVarint(scratch, static_cast<uint64_t>(turns));
+    scratch.insert(scratch.end(), decisions.begin(), decisions.end());
+
+    putVarint(out, scratch.size());
+    out.insert(out.end(), scratch.begin(), scratch.end());
+}
+
+/**
+ * @brief Append-only writer for a record file.
+ * @author Tuan
+ */
+class GameRecordWriter {
+private:
+    FILE* file;
+
+public:
+    GameRecordWriter() : file(nullptr) {}
+    ~GameRecordWriter() { close(); }
+
+    GameRecordWriter(const GameRecordWriter&) = delete;
+    GameRecordWriter& operator=(const GameRecordWriter&) = delete;
+
+    /** Open for appending; writes the file header if the file is new. */
+    bool open(const std::string& path) {
+        close();
+        file = std::fopen(path.c_str(), "ab");
+        if (file == nullptr) {
+            std::cerr << "GameRecordWriter: cannot open " << path << std::endl;
+            return false;
+        }
+        std::fseek(file, 0, SEEK_END);
+        if (std::ftell(file) == 0) {
+            std::fwrite(GAME_RECORD_MAGIC, 1, sizeof(GAME_RECORD_MAGIC), file);
+            std::fputc(GAME_RECORD_VERSION, file);
+        }
+        return true;
+    }
+
+    bool isOpen() const { return file != nullptr; }
+
+    /** Write already-encoded records (see encodeGameRecord). */
+    void append(const std::vector<uint8_t>& records) {
+        if (file != nullptr && !records.empty()) {
+            std::fwrite(records.data(), 1, records.size(), file);
+        }
+    }
+
+    void close() {
+        if (file != nullptr) {
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+};
+
+/**
+ * @brief Memory-mapped sequential reader for a record file.
+ *
+ * The file is mapped read-only and records are decoded in place, so a
+ * scan touches each byte once and never copies decision streams.
+ *
+ * @author Tuan
+ */
+class GameRecordReader {
+private:
+    const uint8_t* data;
+    size_t size;
+    const uint8_t* cursor;
+    bool corrupt;
+
+    bool fail(const char* what) {
+        std::cerr << "GameRecordReader: record at byte " << (cursor - data) << ": " << what << std::endl;
+        corrupt = true;
+        cursor = data + size;
+        return false;
+    }
+
+public:
+    GameRecordReader() : data(nullptr), size(0), cursor(nullptr), corrupt(false) {}
+    ~GameRecordReader() { close(); }
+
+    GameRecordReader(const GameRecordReader&) = delete;
+    GameRecordReader& operator=(const GameRecordReader&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "GameRecordReader: cannot open " << path << std::endl;
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < 5) {
+            std::cerr << "GameRecordReader: " << path << " is not a record file" << std::endl;
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            std::cerr << "GameRecordReader: mmap failed for " << path << std::endl;
+            return false;
+        }
+        madvise(mapped, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+        data = static_cast<const uint8_t*>(mapped);
+        size = static_cast<size_t>(st.st_size);
+        if (std::memcmp(data, GAME_RECORD_MAGIC, 4) != 0 || data[4] != GAME_RECORD_VERSION) {
+            std::cerr << "GameRecordReader: " << path << " has a bad header" << std::endl;
+            close();
+            return false;
+        }
+        rewind();
+        return true;
+    }
+
+    void rewind() {
+        cursor = data + 5;
+        corrupt = false;
+    }
+
+    /** True if reading stopped at a record that does not decode. */
+    bool failed() const { return corrupt; }
+
+    /** Decode the next record into view. Returns false at end or on corruption. */
+    bool next(GameRecordView& view) {
+        const uint8_t* end = data + size;
+        uint64_t length;
+        if (cursor == nullptr || cursor >= end) return false;
+        const uint8_t* p = cursor;
+        if (!getVarint(p, end, length) || length > static_cast<uint64_t>(end - p) || length < 9) {
+            return fail("bad record length");
+        }
+        const uint8_t* recordEnd = p + length;
+
+        view.seed = 0;
+        for (int i = 0; i < 8; i++) view.seed |= static_cast<uint64_t>(p[i]) << (8 * i);
+        view.players = p[8];
+        p += 9;
+        if (view.players < GameEngine::MIN_PLAYERS || view.players > GameEngine::MAX_PLAYERS) {
+            return fail("player count out of range");
+        }
+
+        uint64_t maxTurns, winner, turns;
+        if (!getVarint(p, recordEnd, maxTurns) || !getVarint(p, recordEnd, winner) ||
+            !getVarint(p, recordEnd, turns)) {
+            return fail("bad record header");
+        }
+        cursor = recordEnd;
+        view.maxTurns = static_cast<int>(maxTurns);
+        view.winner = static_cast<int>(winner) - 1;
+        view.turns = static_cast<int>(turns);
+        view.decisions = p;
+        view.decisionBytes = static_cast<size_t>(recordEnd - p);
+        return true;
+    }
+
+    void close() {
+        if (data != nullptr) {
+            munmap(const_cast<uint8_t*>(data), size);
+            data = nullptr;
+            size = 0;
+            cursor = nullptr;
+        }
+    }
+};
+
+#endif // GAMERECORD_H
@@ -0,0 +1,532 @@
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include "GameEngine.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @brief Hosts many tables in one process over a Unix domain socket.
+ *
+ * One thread runs a non-blocking epoll loop. Every table is a GameEngine
+ * driven through its turn state machine (beginTurn / answerCards /
+ * answerPlayDrawn), so a table waiting for a player costs nothing but its
+ * memory, and a connection may hold seats at any number of tables.
+ *
+ * Line protocol (one command per line, fields separated by spaces;
+ * cards are kinds, color * 13 + rank, see Card::kind()):
+ *
+ *   client -> server                    server -> client
+ *   NEW <players> <seed>                TABLE <table>
+ *   SIT <table> <name>                  SEAT <table> <seat>
+ *                                       TURN <table> <seat> <top> <hand kinds, comma-separated>
+ *   PLAY <table> <i>[,<j>...]           (hand indices, lead first)
+ *   DRAW <table>
+ *                                       DRAWN <table> <seat> <card>
+ *   YES <table> | NO <table>            (play the drawn card?)
+ *                                       OVER <table> <winner or -1> <turns>
+ *                                       ABORT <table>   (a seat holder disconnected)
+ *                                       ERROR <message>
+ *
+ * A game starts when its last seat is taken. A connection may have at
+ * most MAX_OPEN_TABLES tables it created waiting for players; they are
+ * aborted if it disconnects first. A line longer than MAX_LINE bytes gets
+ * an ERROR and the connection is closed. Replies are buffered and written
+ * once per batch of events.
+ *
+ * Linux only (epoll).
+ *
+ * @author Tuan
+ */
+class GameServer {
+public:
+    static const int MAX_OPEN_TABLES = 64;   // unstarted tables one connection may have created
+    static const size_t MAX_LINE = 4096;     // longest command line; a longer one closes the connection
+
+private:
+    struct Table {
+        uint32_t id;
+        GameEngine engine;
+        std::vector<int> owners;   // connection fd per seat
+        int players;
+        uint64_t seed;
+        int creator;               // connection fd that sent NEW, -1 once started
+    };
+
+    struct Connection {
+        int fd;
+        std::string in;
+        std::string out;
+        std::vector<uint32_t> tables;   // tables where it holds a seat
+        std::vector<uint32_t> opened;   // tables it created that have not started
+        bool watchingWrites;
+        bool closing;
+    };
+
+    int listenFd;
+    int epollFd;
+    std::unordered_map<uint32_t, std::unique_ptr<Table>> tables;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+    std::vector<int> dirty;   // connections with output to flush
+    std::vector<int> closing; // connections to close once this wakeup's output is flushed
+    uint32_t nextTableId;
+    uint64_t movesPlayed;
+    uint64_t gamesFinished;
+    size_t peakTables;
+
+    // --- Parsing (no exceptions, no copies) ---
+
+    static void skipSpaces(const char*& p, const char* end) {
+        while (p < end && *p == ' ') p++;
+    }
+
+    static bool parseInt(const char*& p, const char* end, long& value) {
+        skipSpaces(p, end);
+        bool negative = (p < end && *p == '-');
+        if (negative) p++;
+        if (p >= end || *p < '0' || *p > '9') return false;
+        value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p++ - '0');
+            if (value > 1000000000000L) return false;
+        }
+        if (negative) value = -value;
+        return true;
+    }
+
+    static bool isWord(const char* p, const char* end, const char* word) {
+        size_t n = std::strlen(word);
+        return static_cast<size_t>(end - p) >= n && std::memcmp(p, word, n) == 0 &&
+               (static_cast<size_t>(end - p) == n || p[n] == ' ');
+    }
+
+    /** Flag c to be closed at the end of the current wakeup. */
+    void markClosing(Connection& c) {
+        if (c.closing) return;
+        c.closing = true;
+        closing.push_back(c.fd);
+    }
+
+    // --- Output ---
+
+    void send(Connection& c, const char* text, size_t n) {
+        if (c.out.empty()) dirty.push_back(c.fd);
+        c.out.append(text, n);
+    }
+
+    void sendf(Connection& c, const char* format, ...) {
+        char buffer[256];
+        va_list args;
+        va_start(args, format);
+        int n = std::vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        if (n > 0) send(c, buffer, std::min(static_cast<size_t>(n), sizeof(buffer) - 1));
+    }
+
+    Connection* connection(int fd) {
+        auto it = connections.find(fd);
+        return it == connections.end() ? nullptr : it->second.get();
+    }
+
+    /** Forget that t's creator is waiting on it (it started or closed). */
+    void releaseCreator(Table& t) {
+        Connection* c = connection(t.creator);
+        t.creator = -1;
+        if (c == nullptr) return;
+        auto& opened = c->opened;
+        opened.erase(std::remove(opened.begin(), opened.end(), t.id), opened.end());
+    }
+
+    void watchWrites(Connection& c, bool on) {
+        if (c.watchingWrites == on) return;
+        epoll_event ev;
+        ev.events = on ? (EPOLLIN | EPOLLOUT) : static_cast<uint32_t>(EPOLLIN);
+        ev.data.fd = c.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &ev);
+        c.watchingWrites = on;
+    }
+
+    void flush(Connection& c) {
+        while (!c.out.empty()) {
+            ssize_t n = ::send(c.fd, c.out.data(), c.out.size(), MSG_NOSIGNAL);
+            if (n > 0) {
+                c.out.erase(0, static_cast<size_t>(n));
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                watchWrites(c, true);
+                return;
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                markClosing(c);
+                return;
+            }
+        }
+        watchWrites(c, false);
+    }
+
+    void flushDirty() {
+        for (int fd : dirty) {
+            Connection* c = connection(fd);
+            if (c != nullptr) flush(*c);
+        }
+        dirty.clear();
+    }
+
+    // --- Tables ---
+
+    /** Run the table until a seat owes a decision, then prompt its owner. */
+    void advance(Table& t) {
+        GameEngine& engine = t.engine;
+        while (!engine.isOver()) {
+            TurnDecision decision = engine.beginTurn();
+            if (decision == DECIDE_NONE) continue;
+
+            int seat = engine.currentSeat();
+            Connection* owner = connection(t.owners[seat]);
+            if (owner == nullptr) return;
+
+            if (decision == DECIDE_CARDS) {
+                char buffer[512];
+                int n = std::snprintf(buffer, sizeof(buffer), "TURN %u %d %d ",
+                                      t.id, seat, engine.topCard().kind());
+                bool first = true;
+                for (Card card : engine.player(seat).hand) {
+                    if (n > static_cast<int>(sizeof(buffer)) - 8) break;
+                    if (!first) buffer[n++] = ',';
+                    n += std::snprintf(buffer + n, sizeof(buffer) - n, "%d", card.kind());
+                    first = false;
+                }
+                buffer[n++] = '\n';
+                send(*owner, buffer, static_cast<size_t>(n));
+            } else {
+                sendf(*owner, "DRAWN %u %d %d\n", t.id, seat, engine.drawnCard().kind());
+            }
+            return;
+        }
+
+        GameResult result = engine.result();
+        gamesFinished++;
+        closeTable(t.id, &result);
+    }
+
+    /** Send OVER (or ABORT when result is null) to every seat holder and drop the table. */
+    void closeTable(uint32_t id, const GameResult* result) {
+        auto it = tables.find(id);
+        if (it == tables.end()) return;
+        std::unique_ptr<Table> t = std::move(it->second);
+        tables.erase(it);
+        releaseCreator(*t);
+
+        std::vector<int>& owners = t->owners;
+        std::sort(owners.begin(), owners.end());
+        owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+        for (int fd : owners) {
+            Connection* c = connection(fd);
+            if (c == nullptr) continue;
+            auto& held = c->tables;
+            held.erase(std::remove(held.begin(), held.end(), id), held.end());
+            if (result != nullptr) sendf(*c, "OVER %u %d %d\n", id, result->winner, result->turns);
+            else sendf(*c, "ABORT %u\n", id);
+        }
+    }
+
+    /** Table id at p owned by c whose current seat belongs to c, or null. */
+    Table* tableForMove(Connection& c, const char*& p, const char* end) {
+        long id;
+        if (!parseInt(p, end, id)) {
+            sendf(c, "ERROR missing table\n");
+            return nullptr;
+        }
+        auto it = tables.find(static_cast<uint32_t>(id));
+        if (it == tables.end()) {
+            sendf(c, "ERROR no table %ld\n", id);
+            return nullptr;
+        }
+        Table& t = *it->second;
+        if (t.engine.pendingDecision() == DECIDE_NONE ||
+            t.owners[t.engine.currentSeat()] != c.fd) {
+            sendf(c, "ERROR not your turn at table %ld\n", id);
+            return nullptr;
+        }
+        return &t;
+    }
+
+    // --- Commands ---
+
+    void handleLine(Connection& c, const char* p, const char* end) {
+        if (isWord(p, end, "PLAY") || isWord(p, end, "DRAW")) {
+            bool draw = (*p == 'D');
+            p += 4;
+            Table* t = tableForMove(c, p, end);
+            if (t == nullptr) return;
+            if (t->engine.pendingDecision() != DECIDE_CARDS) {
+                sendf(c, "ERROR table %u expects YES or NO\n", t->id);
+                return;
+            }
+
+            std::vector<int> indices;
+            if (!draw) {
+                long index;
+                while (parseInt(p, end, index)) {
+                    indices.push_back(static_cast<int>(index));
+                    if (p < end && *p == ',') p++;
+                }
+                const Player& player = t->engine.player(t->engine.currentSeat());
+                if (!GameEngine::isValidSelection(player, indices, t->engine.topCard(), nullptr)) {
+                    sendf(c, "ERROR illegal play at table %u\n", t->id);
+                    return;
+                }
+            }
+            t->engine.answerCards(indices);
+            movesPlayed++;
+            advance(*t);
+        } else if (isWord(p, end, "YES") || isWord(p, end, "NO")) {
+            bool play = (*p == 'Y');
+            p += play ? 3 : 2;
+            Table* t = tableForMove(c, p, end);
+            if (t == nullptr) return;
+            if (t->engine.pendingDecision() != DECIDE_PLAY_DRAWN) {
+                sendf(c, "ERROR table %u expects PLAY or DRAW\n", t->id);
+                return;
+            }
+            t->engine.answerPlayDrawn(play);
+            movesPlayed++;
+            advance(*t);
+        } else if (isWord(p, end, "NEW")) {
+            p += 3;
+            long players, seed;
+            if (!parseInt(p, end, players) || !parseInt(p, end, seed) ||
+                players < GameEngine::MIN_PLAYERS || players > GameEngine::MAX_PLAYERS) {
+                sendf(c, "ERROR usage: NEW <players %d-%d> <seed>\n",
+                      GameEngine::MIN_PLAYERS, GameEngine::MAX_PLAYERS);
+                return;
+            }
+            if (c.opened.size() >= static_cast<size_t>(MAX_OPEN_TABLES)) {
+                sendf(c, "ERROR %d tables already waiting for players\n", MAX_OPEN_TABLES);
+                return;
+            }
+            std::unique_ptr<Table> t(new Table());
+            t->id = nextTableId++;
+            t->players = static_cast<int>(players);
+            t->seed = static_cast<uint64_t>(seed);
+            t->creator = c.fd;
+            t->engine.setMaxTurns(GameEngine::DEFAULT_MAX_TURNS);
+            c.opened.push_back(t->id);
+            sendf(c, "TABLE %u\n", t->id);
+            tables[t->id] = std::move(t);
+            peakTables = std::max(peakTables, tables.size());
+        } else if (isWord(p, end, "SIT")) {
+            p += 3;
+            long id;
+            if (!parseInt(p, end, id)) {
+                sendf(c, "ERROR usage: SIT <table> <name>\n");
+                return;
+            }
+            auto it = tables.find(static_cast<uint32_t>(id));
+            if (it == tables.end() ||
+                static_cast<int>(it->second->owners.size()) >= it->second->players) {
+                sendf(c, "ERROR table %ld is not open\n", id);
+                return;
+            }
+            Table& t = *it->second;
+            skipSpaces(p, end);
+            std::string name(p, end);
+            if (name.empty()) name = "Player " + std::to_string(t.owners.size() + 1);
+
+            int seat = static_cast<int>(t.owners.size());
+            t.engine.addPlayer(name, nullptr);
+            t.owners.push_back(c.fd);
+            if (std::find(c.tables.begin(), c.tables.end(), t.id) == c.tables.end()) {
+                c.tables.push_back(t.id);
+            }
+            sendf(c, "SEAT %u %d\n", t.id, seat);
+
+            if (static_cast<int>(t.owners.size()) == t.players) {
+                releaseCreator(t);
+                t.engine.start(t.seed);
+                advance(t);
+            }
+        } else if (p < end) {
+            sendf(c, "ERROR unknown command\n");
+        }
+    }
+
+    // --- Connections ---
+
+    void accept() {
+        while (true) {
+            int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;   // EAGAIN: no more pending connections
+            epoll_event ev;
+            ev.events = EPOLLIN;
+            ev.data.fd = fd;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+                ::close(fd);
+                continue;
+            }
+            std::unique_ptr<Connection> c(new Connection());
+            c->fd = fd;
+            c->watchingWrites = false;
+            c->closing = false;
+            connections[fd] = std::move(c);
+        }
+    }
+
+    /** Run every complete line in c.in and keep the unfinished rest. */
+    void handleLines(Connection& c) {
+        size_t start = 0;
+        while (true) {
+            size_t newline = c.in.find('\n', start);
+            if (newline == std::string::npos) break;
+            size_t stop = newline;
+            if (stop > start && c.in[stop - 1] == '\r') stop--;
+            handleLine(c, c.in.data() + start, c.in.data() + stop);
+            start = newline + 1;
+        }
+        c.in.erase(0, start);
+        if (c.in.size() > MAX_LINE) {
+            sendf(c, "ERROR line longer than %zu bytes\n", MAX_LINE);
+            c.in.clear();
+            markClosing(c);
+        }
+    }
+
+    /** Read until the socket is drained, running lines as each chunk arrives. */
+    void readFrom(Connection& c) {
+        char buffer[1 << 16];
+        while (!c.closing) {
+            ssize_t n = ::read(c.fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                c.in.append(buffer, static_cast<size_t>(n));
+                handleLines(c);
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) markClosing(c);
+            break;
+        }
+    }
+
+    void closeConnection(int fd) {
+        Connection* c = connection(fd);
+        if (c == nullptr) return;
+        // Games it plays in and tables it created that never started are aborted
+        std::vector<uint32_t> held = c->tables;
+        held.insert(held.end(), c->opened.begin(), c->opened.end());
+        for (uint32_t id : held) closeTable(id, nullptr);
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+        connections.erase(fd);
+    }
+
+public:
+    GameServer()
+        : listenFd(-1), epollFd(-1), nextTableId(1), movesPlayed(0),
+          gamesFinished(0), peakTables(0) {}
+
+    ~GameServer() {
+        std::vector<int> fds;
+        for (auto& entry : connections) fds.push_back(entry.first);
+        for (int fd : fds) closeConnection(fd);
+        if (listenFd >= 0) ::close(listenFd);
+        if (epollFd >= 0) ::close(epollFd);
+    }
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    /** Bind and listen on a Unix socket path (an old socket file is replaced). */
+    bool listen(const std::string& path) {
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            std::cerr << "GameServer: socket path too long: " << path << std::endl;
+            return false;
+        }
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+        listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        ::unlink(path.c_str());
+        if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listenFd, SOMAXCONN) != 0) {
+            std::cerr << "GameServer: cannot listen on " << path << ": "
+                      << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.fd = listenFd;
+        if (epollFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev) != 0) {
+            std::cerr << "GameServer: epoll setup failed: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /** Serve until stopFlag becomes nonzero (e.g. set by a signal handler). */
+    void run(const volatile std::sig_atomic_t& stopFlag) {
+        const int MAX_EVENTS = 256;
+        epoll_event events[MAX_EVENTS];
+        std::vector<int> closingNow;
+
+        while (!stopFlag) {
+            int n = epoll_wait(epollFd, events, MAX_EVENTS, 200);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                std::cerr << "GameServer: epoll_wait failed: " << std::strerror(errno) << std::endl;
+                return;
+            }
+
+            for (int i = 0; i < n; i++) {
+                int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    accept();
+                    continue;
+                }
+                Connection* c = connection(fd);
+                if (c == nullptr) continue;
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) readFrom(*c);
+                if (events[i].events & EPOLLOUT) flush(*c);
+            }
+            flushDirty();
+
+            // Aborting a connection's tables can fail a flush to another, which queues it too
+            while (!closing.empty()) {
+                closingNow.swap(closing);
+                for (int fd : closingNow) closeConnection(fd);
+                closingNow.clear();
+                flushDirty();
+            }
+        }
+    }
+
+    size_t tableCount() const { return tables.size(); }
+    size_t connectionCount() const { return connections.size(); }
+    size_t peakTableCount() const { return peakTables; }
+    uint64_t moves() const { return movesPlayed; }
+    uint64_t games() const { return gamesFinished; }
+
+    /** Approximate bytes held per table, excluding player name strings. */
+    static size_t tableBytes() { return sizeof(Table); }
+};
+
+#endif // GAMESERVER_H
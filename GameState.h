@@ -0,0 +1,53 @@
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include "Card.h"
+#include "Deck.h"
+#include "Player.h"
+#include "TurnRing.h"
+#include <type_traits>
+
+/**
+ * @brief Everything that changes during a game, as one flat value.
+ *
+ * Deck, hands, turn order, top card and the game's progress all live in
+ * fixed-size members with no pointers, so a position is cloned with a
+ * plain copy (about a kilobyte) and restored the same way. Search
+ * players can snapshot the table, play ahead on the copy and throw it
+ * away.
+ *
+ * The engine keeps what does not change during play (names, policies,
+ * the observer, the turn limit) outside the state.
+ *
+ * Note that the deck's generator is part of the state: a copy draws the
+ * same cards as the original until its deck is reseeded.
+ *
+ * @author Tuan
+ */
+struct GameState {
+    static constexpr int MAX_PLAYERS = 10;
+
+    Deck deck;
+    Player players[MAX_PLAYERS];
+    TurnRing order;
+    Card topCard;
+    int numPlayers;
+    int winner;      // seat of the winner, -1 while playing or after a draw
+    int turnCount;
+    int penalty;     // cards the current seat owes to stacked Draw Twos (penalty stacking only)
+    bool over;
+
+    GameState() : numPlayers(0), winner(-1), turnCount(0), penalty(0), over(false) {
+        for (int i = 0; i < MAX_PLAYERS; i++) players[i].seat = i;
+    }
+
+    int currentSeat() const { return order.current(); }
+    const Player& current() const { return players[order.current()]; }
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value,
+              "GameState must copy with memcpy");
+static_assert(GameState::MAX_PLAYERS <= TurnRing::MAX_SEATS,
+              "TurnRing must hold every seat");
+
+#endif // GAMESTATE_H
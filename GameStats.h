@@ -0,0 +1,306 @@
+#ifndef GAMESTATS_H
+#define GAMESTATS_H
+
+#include "GameObserver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Fixed-memory quantile sketch over non-negative integers.
+ *
+ * Values below EXACT are counted exactly; larger ones fall in logarithmic
+ * buckets 2% wide, so any quantile is within 1% of the true value. The
+ * buckets are fixed, so two sketches merge by adding counts and the result
+ * does not depend on how values were split between them or in what order
+ * they came. Memory is about 9 KB whatever the number of values.
+ *
+ * @author Tuan
+ */
+class QuantileSketch {
+public:
+    static const int EXACT = 256;
+    static constexpr double GAMMA = 1.0202;   // (1 + 1%) / (1 - 1%)
+    static const int LOG_BUCKETS = 840;       // EXACT * GAMMA^840 > 2^32
+
+private:
+    uint64_t counts[EXACT + LOG_BUCKETS];
+    uint64_t total;
+    uint64_t maxValue;
+
+    static int bucketOf(uint64_t value) {
+        if (value < EXACT) return static_cast<int>(value);
+        int b = static_cast<int>(std::log(static_cast<double>(value) / EXACT) / std::log(GAMMA));
+        return EXACT + std::min(b, LOG_BUCKETS - 1);
+    }
+
+    /** A value that represents bucket b (its geometric midpoint). */
+    static double valueOf(int b) {
+        if (b < EXACT) return b;
+        int k = b - EXACT;
+        return EXACT * std::pow(GAMMA, k + 0.5);
+    }
+
+public:
+    QuantileSketch() : counts(), total(0), maxValue(0) {}
+
+    void add(uint64_t value) {
+        counts[bucketOf(value)]++;
+        total++;
+        if (value > maxValue) maxValue = value;
+    }
+
+    void merge(const QuantileSketch& other) {
+        for (int b = 0; b < EXACT + LOG_BUCKETS; b++) counts[b] += other.counts[b];
+        total += other.total;
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return maxValue; }
+
+    /** Value of the rank-th smallest value (0-based), clamped to the range. */
+    double atRank(uint64_t rank) const {
+        if (total == 0) return 0.0;
+        if (rank >= total) rank = total - 1;
+        uint64_t seen = 0;
+        for (int b = 0; b < EXACT + LOG_BUCKETS; b++) {
+            seen += counts[b];
+            if (seen > rank) return std::min(valueOf(b), static_cast<double>(maxValue));
+        }
+        return static_cast<double>(maxValue);
+    }
+
+    double quantile(double q) const {
+        return total ? atRank(static_cast<uint64_t>(q * (total - 1) + 0.5)) : 0.0;
+    }
+
+    /**
+     * Distribution-free confidence interval for quantile q: the values at
+     * ranks n*q -/+ z*sqrt(n*q*(1-q)) (z = 1.96 for 95%).
+     */
+    void quantileInterval(double q, double z, double& low, double& high) const {
+        double n = static_cast<double>(total);
+        double spread = z * std::sqrt(n * q * (1.0 - q));
+        double lowRank = std::max(0.0, std::floor(n * q - spread));
+        double highRank = std::min(n - 1.0, std::ceil(n * q + spread));
+        low = atRank(static_cast<uint64_t>(lowRank));
+        high = atRank(static_cast<uint64_t>(std::max(0.0, highRank)));
+    }
+};
+
+/**
+ * @brief Count, sum and sum of squares of integer samples.
+ *
+ * Kept as integers so merging is exact and order-independent. Fine for
+ * values up to about 10^5 over 10^9 samples.
+ *
+ * @author Tuan
+ */
+struct Moments {
+    uint64_t n;
+    uint64_t sum;
+    uint64_t sumSquares;
+
+    Moments() : n(0), sum(0), sumSquares(0) {}
+
+    void add(uint64_t value) {
+        n++;
+        sum += value;
+        sumSquares += value * value;
+    }
+
+    void merge(const Moments& other) {
+        n += other.n;
+        sum += other.sum;
+        sumSquares += other.sumSquares;
+    }
+
+    double mean() const { return n ? static_cast<double>(sum) / n : 0.0; }
+
+    double stddev() const {
+        if (n < 2) return 0.0;
+        double m = mean();
+        double variance = (static_cast<double>(sumSquares) - n * m * m) / (n - 1);
+        return variance > 0 ? std::sqrt(variance) : 0.0;
+    }
+
+    /** Half-width of the normal confidence interval for the mean. */
+    double meanError(double z) const { return n ? z * stddev() / std::sqrt(static_cast<double>(n)) : 0.0; }
+};
+
+/**
+ * Wilson score interval for a proportion of k successes in n trials;
+ * unlike p +/- z*sqrt(p(1-p)/n) it stays inside [0, 1] for rare events.
+ */
+inline void wilsonInterval(uint64_t k, uint64_t n, double z, double& low, double& high) {
+    if (n == 0) {
+        low = 0.0;
+        high = 1.0;
+        return;
+    }
+    double p = static_cast<double>(k) / n;
+    double z2 = z * z;
+    double denom = 1.0 + z2 / n;
+    double centre = (p + z2 / (2.0 * n)) / denom;
+    double half = z * std::sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / denom;
+    low = std::max(0.0, centre - half);
+    high = std::min(1.0, centre + half);
+}
+
+/**
+ * @brief Streaming statistics over any number of games, in constant memory.
+ *
+ * Win counts per seat, game lengths, cards drawn per game (after the
+ * deal) and plays by stack size. Each thread keeps its own GameStats and
+ * the totals are merged once at the end; every part merges by plain
+ * addition, so the report is the same for any split of the games.
+ *
+ * @author Tuan
+ */
+class GameStats {
+public:
+    static const int MAX_SEATS = 16;
+    static const int STACK_SIZES = 8;    // plays of 1..7 cards, then 8 or more
+
+private:
+    uint64_t wins[MAX_SEATS];
+    uint64_t draws;
+    uint64_t stacks[STACK_SIZES];
+    QuantileSketch turnSketch;
+    QuantileSketch drawnSketch;
+    Moments turnMoments;
+    Moments drawnMoments;
+
+public:
+    GameStats() : wins(), draws(0), stacks() {}
+
+    /** One finished game; winner is -1 for a draw. */
+    void addGame(int winner, int turns, int cardsDrawn) {
+        if (winner >= 0 && winner < MAX_SEATS) {
+            wins[winner]++;
+        } else {
+            draws++;
+        }
+        turnSketch.add(static_cast<uint64_t>(turns));
+        drawnSketch.add(static_cast<uint64_t>(cardsDrawn));
+        turnMoments.add(static_cast<uint64_t>(turns));
+        drawnMoments.add(static_cast<uint64_t>(cardsDrawn));
+    }
+
+    /** One play of n cards. */
+    void addStack(int n) {
+        if (n < 1) return;
+        stacks[std::min(n, STACK_SIZES) - 1]++;
+    }
+
+    void merge(const GameStats& other) {
+        for (int s = 0; s < MAX_SEATS; s++) wins[s] += other.wins[s];
+        draws += other.draws;
+        for (int n = 0; n < STACK_SIZES; n++) stacks[n] += other.stacks[n];
+        turnSketch.merge(other.turnSketch);
+        drawnSketch.merge(other.drawnSketch);
+        turnMoments.merge(other.turnMoments);
+        drawnMoments.merge(other.drawnMoments);
+    }
+
+    uint64_t games() const { return turnMoments.n; }
+    uint64_t winsOf(int seat) const { return wins[seat]; }
+    uint64_t drawCount() const { return draws; }
+    uint64_t stackCount(int n) const { return stacks[std::min(n, STACK_SIZES) - 1]; }
+    const QuantileSketch& turns() const { return turnSketch; }
+    const QuantileSketch& cardsDrawn() const { return drawnSketch; }
+    const Moments& turnTotals() const { return turnMoments; }
+    const Moments& drawnTotals() const { return drawnMoments; }
+
+    /** Print a report with 95% confidence intervals. */
+    void print(std::ostream& os, const std::vector<std::string>& seatNames) const {
+        const double Z = 1.96;
+        char line[200];
+        uint64_t n = games();
+
+        os << "Win rate (95% CI)\n";
+        for (size_t s = 0; s < seatNames.size() && s < static_cast<size_t>(MAX_SEATS); s++) {
+            double low, high;
+            wilsonInterval(wins[s], n, Z, low, high);
+            std::snprintf(line, sizeof(line), "  %-16s %6.2f%%  [%6.2f%%, %6.2f%%]\n", seatNames[s].c_str(),
+                          n ? 100.0 * wins[s] / n : 0.0, 100.0 * low, 100.0 * high);
+            os << line;
+        }
+
+        printDistribution(os, "Game length (turns)", turnSketch, turnMoments, Z);
+        printDistribution(os, "Cards drawn per game", drawnSketch, drawnMoments, Z);
+
+        uint64_t plays = 0;
+        for (int k = 0; k < STACK_SIZES; k++) plays += stacks[k];
+        os << "Plays by cards stacked\n";
+        for (int k = 0; k < STACK_SIZES; k++) {
+            std::snprintf(line, sizeof(line), "  %d%-3s %14llu  %7.3f%%\n", k + 1, k + 1 < STACK_SIZES ? "" : "+",
+                          static_cast<unsigned long long>(stacks[k]), plays ? 100.0 * stacks[k] / plays : 0.0);
+            os << line;
+        }
+        os.flush();
+    }
+
+private:
+    static void printDistribution(std::ostream& os, const char* title, const QuantileSketch& sketch,
+                                  const Moments& moments, double z) {
+        char line[200];
+        std::snprintf(line, sizeof(line), "%s: mean %.2f +/- %.2f, sd %.2f, max %llu\n", title,
+                      moments.mean(), moments.meanError(z), moments.stddev(),
+                      static_cast<unsigned long long>(sketch.max()));
+        os << line;
+        const double QS[] = { 0.10, 0.50, 0.90, 0.99, 0.999 };
+        for (double q : QS) {
+            double low, high;
+            sketch.quantileInterval(q, z, low, high);
+            std::snprintf(line, sizeof(line), "  p%-5g %10.1f  [%.1f, %.1f]\n", q * 100, sketch.quantile(q), low, high);
+            os << line;
+        }
+    }
+};
+
+/**
+ * @brief Observer that feeds a GameStats as games are played.
+ *
+ * Counts the cards each seat draws during play (forced draws and Draw Two
+ * penalties, not the deal) and every play's stack size, and adds the game
+ * when a winner is found or the turn limit ends it.
+ *
+ * @author Tuan
+ */
+class StatsObserver : public NullObserver {
+private:
+    GameStats totals;
+    int drawnThisGame;
+
+public:
+    StatsObserver() : drawnThisGame(0) {}
+
+    const GameStats& stats() const { return totals; }
+    GameStats& stats() { return totals; }
+
+    template <typename Game>
+    void onGameStart(const Game&) { drawnThisGame = 0; }
+
+    template <typename Game>
+    void onCardDrawn(const Game&, int, Card) { drawnThisGame++; }
+
+    template <typename Game>
+    void onCardsPlayed(const Game&, int, const Card*, int count) { totals.addStack(count); }
+
+    template <typename Game>
+    void onEffect(const Game&, CardType, int, int, int drawn) { drawnThisGame += drawn; }
+
+    template <typename Game>
+    void onWinner(const Game& game, int seat) { totals.addGame(seat, game.turns(), drawnThisGame); }
+
+    template <typename Game>
+    void onDraw(const Game& game) { totals.addGame(-1, game.turns(), drawnThisGame); }
+};
+
+#endif // GAMESTATS_H
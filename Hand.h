@@ -0,0 +1,158 @@
+#ifndef HAND_H
+#define HAND_H
+
+#include "Card.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+
+/**
+ * @brief A player's hand stored as a count per card kind plus a bitmask.
+ *
+ * Bit k of the mask is set while the hand holds at least one card of kind k
+ * (see Card::kind()). Playability and stacking checks AND the mask with a
+ * row of CARD_TABLES, so each is one load and one AND.
+ *
+ * Indices follow kind order (by color, then number, then actions), so
+ * index-based access like playCard(int) keeps working; the hand simply
+ * displays sorted.
+ *
+ * @author Tam
+ */
+class Hand {
+private:
+    uint64_t present;
+    uint8_t counts[Card::NUM_KINDS];
+    int total;
+
+    static int lowestBit(uint64_t mask) { return __builtin_ctzll(mask); }
+
+public:
+    /** Kinds that can be played on topCard (same color, number or action). */
+    static uint64_t playableOn(const Card& topCard) {
+        return CARD_TABLES.playableOn[topCard.kind()];
+    }
+
+    /** Kinds that stack with lead (same number or same action). */
+    static uint64_t stackableWith(const Card& lead) {
+        return CARD_TABLES.stackableWith[lead.kind()];
+    }
+
+    /** @brief Walks the hand in index order, yielding one Card per copy. */
+    class const_iterator {
+    private:
+        const Hand* hand;
+        uint64_t mask;   // kinds not yet finished
+        int copy;        // copies of the lowest kind already visited
+
+    public:
+        using iterator_category = std::input_iterator_tag;   // yields Cards by value
+        using value_type = Card;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Card*;
+        using reference = Card;
+
+        const_iterator(const Hand* hand, uint64_t mask) : hand(hand), mask(mask), copy(0) {}
+
+        Card operator*() const { return Card::fromKind(lowestBit(mask)); }
+
+        const_iterator& operator++() {
+            if (++copy >= hand->counts[lowestBit(mask)]) {
+                mask &= mask - 1;
+                copy = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return mask == other.mask && copy == other.copy;
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+
+    Hand() { clear(); }
+
+    const_iterator begin() const { return const_iterator(this, present); }
+    const_iterator end() const { return const_iterator(this, 0); }
+
+    void clear() {
+        for (int k = 0; k < Card::NUM_KINDS; k++) counts[k] = 0;
+        present = 0;
+        total = 0;
+    }
+
+    void add(const Card& card) {
+        int k = card.kind();
+        counts[k]++;
+        present |= 1ULL << k;
+        total++;
+    }
+
+    /** Remove one card of the given kind. Returns false if there is none. */
+    bool removeKind(int kind) {
+        if (counts[kind] == 0) return false;
+        if (--counts[kind] == 0) present &= ~(1ULL << kind);
+        total--;
+        return true;
+    }
+
+    bool remove(const Card& card) { return removeKind(card.kind()); }
+
+    /** Kind of the card at the given index in kind order, or -1. */
+    int kindAt(int index) const {
+        if (index < 0 || index >= total) return -1;
+        uint64_t mask = present;
+        while (mask) {
+            int k = lowestBit(mask);
+            if (index < counts[k]) return k;
+            index -= counts[k];
+            mask &= mask - 1;
+        }
+        return -1;
+    }
+
+    /** Index of the first card of the given kind (or where it would go). */
+    int indexOf(int kind) const {
+        int index = 0;
+        uint64_t mask = present & ((1ULL << kind) - 1);
+        while (mask) {
+            index += counts[lowestBit(mask)];
+            mask &= mask - 1;
+        }
+        return index;
+    }
+
+    Card get(int index) const {
+        int k = kindAt(index);
+        if (k < 0) {
+            std::cerr << "get: index " << index << " out of range" << std::endl;
+            return Card();
+        }
+        return Card::fromKind(k);
+    }
+
+    void removeAt(int index) {
+        int k = kindAt(index);
+        if (k < 0) {
+            std::cerr << "removeAt: index " << index << " out of range" << std::endl;
+            return;
+        }
+        removeKind(k);
+    }
+
+    int count(int kind) const { return counts[kind]; }
+    uint64_t kinds() const { return present; }
+    int size() const { return total; }
+    bool isEmpty() const { return total == 0; }
+
+    /** Kinds in this hand playable on topCard. */
+    uint64_t playableKinds(const Card& topCard) const { return present & playableOn(topCard); }
+
+    bool hasPlayable(const Card& topCard) const { return playableKinds(topCard) != 0; }
+
+    /** Kinds in this hand that stack with lead (including lead's own kind). */
+    uint64_t stackKinds(const Card& lead) const { return present & stackableWith(lead); }
+};
+
+#endif // HAND_H
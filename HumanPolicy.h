@@ -0,0 +1,133 @@
+#ifndef HUMANPOLICY_H
+#define HUMANPOLICY_H
+
+#include "GameEngine.h"
+#include "PlayerPolicy.h"
+#include "TranscriptRecorder.h"
+#include <climits>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Interactive policy that asks a human at the terminal.
+ *
+ * Reads card selections from std::cin and re-prompts until the
+ * selection passes GameEngine::isValidSelection. The parsing is static
+ * and works on a line in place, so TranscriptPolicy (Transcript.h)
+ * replays typed lines exactly as they were read here. With recordTo set,
+ * every line read is also appended there in transcript form.
+ *
+ * @author Tuan
+ */
+class HumanPolicy : public PlayerPolicy {
+private:
+    std::string* transcript;
+
+    /** Read one line from std::cin, recording it if asked to. */
+    void readLine(std::string& line) {
+        if (!std::getline(std::cin, line)) return;
+        if (transcript != nullptr) TranscriptRecorder::writeTyped(*transcript, line);
+    }
+
+public:
+    HumanPolicy() : transcript(nullptr) {}
+
+    /** Append every line read to lines (nullptr stops recording). */
+    void recordTo(std::string* lines) { transcript = lines; }
+
+    /** What one line typed at the card prompt asks for. */
+    enum Answer { ANSWER_INVALID, ANSWER_DRAW, ANSWER_PLAY };
+
+    /**
+     * Parse one integer token as std::stoi would: leading whitespace, an
+     * optional sign, then digits; anything after the digits is ignored.
+     * Returns false where stoi would throw (no digits, out of int range).
+     */
+    static bool parseInt(const char* p, const char* end, int& value) {
+        while (p < end && (*p == '\t' || *p == '\n' || *p == '\v' || *p == '\f' || *p == '\r')) p++;
+        bool negative = false;
+        if (p < end && (*p == '+' || *p == '-')) negative = (*p++ == '-');
+        if (p == end || *p < '0' || *p > '9') return false;
+        long long v = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            v = v * 10 + (*p++ - '0');
+            if (v > static_cast<long long>(INT_MAX) + 1) return false;
+        }
+        if (negative) v = -v;
+        if (v > INT_MAX || v < INT_MIN) return false;
+        value = static_cast<int>(v);
+        return true;
+    }
+
+    /**
+     * Parse comma-separated indices from [begin, end), e.g. "3,4" or
+     * "3, 4" or "3". Leaves indices empty if any token is not a number.
+     */
+    static void parseIndices(const char* begin, const char* end, std::vector<int>& indices) {
+        indices.clear();
+        const char* token = begin;
+        for (const char* p = begin; p <= end; p++) {
+            if (p < end && *p != ',' && *p != ' ') continue;
+            int value;
+            if (p > token) {
+                if (!parseInt(token, p, value)) {
+                    indices.clear();
+                    return;
+                }
+                indices.push_back(value);
+            }
+            token = p + 1;
+        }
+    }
+
+    /**
+     * Read one line typed at the card prompt for seat. ANSWER_PLAY leaves
+     * a valid selection in indices; reasons for a rejection go to out
+     * when it is set.
+     */
+    static Answer readSelection(const char* begin, const char* end, const GameState& state, int seat,
+                                std::vector<int>& indices, std::ostream* out) {
+        parseIndices(begin, end, indices);
+        if (indices.empty()) {
+            if (out) *out << "Invalid input. Try again." << std::endl;
+            return ANSWER_INVALID;
+        }
+        if (indices.size() == 1 && indices[0] == -1) {
+            indices.clear();
+            return ANSWER_DRAW;
+        }
+        if (!GameEngine::isValidSelection(state.players[seat], indices, state.topCard, out)) {
+            return ANSWER_INVALID;
+        }
+        return ANSWER_PLAY;
+    }
+
+    /** Whether a line typed at the play-drawn-card prompt means yes. */
+    static bool readYes(const char* begin, const char* end) {
+        return begin < end && (*begin == 'y' || *begin == 'Y');
+    }
+
+    /** Prompt for card indices. Leaves validated indices, or none to draw. */
+    void chooseCards(const GameState& state, int seat, std::vector<int>& indices) override {
+        while (true) {
+            std::cout << "\nPlay card(s) (e.g. 0 or 0,2) or -1 to draw: ";
+            std::string line;
+            readLine(line);
+
+            const char* text = line.data();
+            if (readSelection(text, text + line.size(), state, seat, indices, &std::cout) != ANSWER_INVALID) {
+                return;
+            }
+        }
+    }
+
+    bool playDrawnCard(const GameState&, int, const Card&) override {
+        std::cout << "You can play the drawn card! Play it? (y/n): ";
+        std::string input;
+        readLine(input);
+        return readYes(input.data(), input.data() + input.size());
+    }
+};
+
+#endif // HUMANPOLICY_H
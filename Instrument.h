@@ -0,0 +1,270 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief Event counters and latency histograms for the game's hot paths.
+ *
+ * The engine and the deck call the UNO_COUNT / UNO_STACK / UNO_TIMED
+ * macros below. They record only when the program is built with
+ * -DUNO_INSTRUMENT; otherwise they expand to nothing and the hot paths
+ * compile exactly as before.
+ *
+ * Each thread records into its own buffer, so recording takes no lock and
+ * shares no cache line. Buffers register themselves once and live until
+ * the program exits, so counts from finished worker threads stay in the
+ * totals. summary() adds all buffers up and may be called at any time
+ * from any thread. Latencies go into log2 buckets of nanoseconds.
+ *
+ * @author Tuan
+ */
+class Instrument {
+public:
+    enum Counter {
+        TURNS,           // turns started
+        DECISIONS,       // policy decisions asked for by step()
+        DRAWS,           // cards drawn from the deck
+        FORCED_DRAWS,    // turns that began with no playable card
+        PENALTY_DRAWS,   // cards drawn because of Draw Two stacks
+        SHUFFLES,        // whole-deck shuffles (lazy or eager)
+        RESHUFFLES,      // discard pile turned into the draw pile
+        COUNTER_COUNT
+    };
+
+    enum Timer {
+        TIMER_TURN,      // a whole step(): decision, play and effects
+        TIMER_DECISION,  // the seat's policy choosing
+        TIMER_EFFECTS,   // applyStackedEffects
+        TIMER_SHUFFLE,   // shuffleAll / recycleDiscards
+        TIMER_DRAW,      // drawFromDeck
+        TIMER_COUNT
+    };
+
+    static const int BUCKETS = 64;      // bucket b holds [2^(b-1), 2^b) ns
+    static const int STACK_SIZES = 8;   // plays of 1..7 cards, then 8 or more
+
+    /** Merged latencies of one timer. */
+    struct Histogram {
+        uint64_t buckets[BUCKETS];
+        uint64_t count;
+        uint64_t totalNs;
+        uint64_t maxNs;
+
+        Histogram() : buckets(), count(0), totalNs(0), maxNs(0) {}
+
+        double meanNs() const { return count ? static_cast<double>(totalNs) / count : 0.0; }
+
+        /** Upper bound of the bucket holding quantile q. */
+        uint64_t percentileNs(double q) const {
+            uint64_t rank = static_cast<uint64_t>(q * count);
+            uint64_t seen = 0;
+            for (int b = 0; b < BUCKETS; b++) {
+                seen += buckets[b];
+                if (seen > rank) return b == 0 ? 0 : (b >= 63 ? maxNs : (1ULL << b) - 1);
+            }
+            return maxNs;
+        }
+    };
+
+    struct Summary {
+        uint64_t counters[COUNTER_COUNT];
+        uint64_t stacks[STACK_SIZES];   // stacks[n - 1]: plays of n cards
+        Histogram timers[TIMER_COUNT];
+        int threads;
+
+        Summary() : counters(), stacks(), threads(0) {}
+    };
+
+private:
+    // Written only by the owning thread; relaxed atomics let summary() read
+    // them while it runs and compile to plain loads and stores.
+    struct alignas(64) Buffer {
+        std::atomic<uint64_t> counters[COUNTER_COUNT];
+        std::atomic<uint64_t> stacks[STACK_SIZES];
+        std::atomic<uint64_t> buckets[TIMER_COUNT][BUCKETS];
+        std::atomic<uint64_t> totalNs[TIMER_COUNT];
+        std::atomic<uint64_t> maxNs[TIMER_COUNT];
+
+        Buffer() : counters(), stacks(), buckets(), totalNs(), maxNs() {}
+    };
+
+    struct Registry {
+        std::mutex lock;
+        std::vector<std::unique_ptr<Buffer>> buffers;
+    };
+
+    static Registry& registry() {
+        static Registry r;
+        return r;
+    }
+
+    static Buffer& local() {
+        thread_local Buffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> guard(r.lock);
+            r.buffers.emplace_back(new Buffer());
+            buffer = r.buffers.back().get();
+        }
+        return *buffer;
+    }
+
+    static void bump(std::atomic<uint64_t>& slot, uint64_t by = 1) {
+        slot.store(slot.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    static int bucketOf(uint64_t ns) { return ns == 0 ? 0 : 64 - __builtin_clzll(ns); }
+
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static void count(Counter c, uint64_t by = 1) { bump(local().counters[c], by); }
+
+    /** A play of n cards. */
+    static void stack(int n) {
+        if (n < 1) return;
+        bump(local().stacks[n < STACK_SIZES ? n - 1 : STACK_SIZES - 1]);
+    }
+
+    static void record(Timer t, uint64_t ns) {
+        Buffer& b = local();
+        bump(b.buckets[t][bucketOf(ns)]);
+        bump(b.totalNs[t], ns);
+        if (ns > b.maxNs[t].load(std::memory_order_relaxed)) {
+            b.maxNs[t].store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    /** Records the time from construction to destruction under one timer. */
+    class Scope {
+    private:
+        Timer timer;
+        Clock::time_point start;
+
+    public:
+        explicit Scope(Timer timer) : timer(timer), start(Clock::now()) {}
+        ~Scope() {
+            record(timer, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /** Totals over every thread that has recorded anything. */
+    static Summary summary() {
+        Summary s;
+        Registry& r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        s.threads = static_cast<int>(r.buffers.size());
+        for (const std::unique_ptr<Buffer>& b : r.buffers) {
+            for (int c = 0; c < COUNTER_COUNT; c++) s.counters[c] += b->counters[c].load(std::memory_order_relaxed);
+            for (int n = 0; n < STACK_SIZES; n++) s.stacks[n] += b->stacks[n].load(std::memory_order_relaxed);
+            for (int t = 0; t < TIMER_COUNT; t++) {
+                Histogram& h = s.timers[t];
+                for (int k = 0; k < BUCKETS; k++) {
+                    uint64_t v = b->buckets[t][k].load(std::memory_order_relaxed);
+                    h.buckets[k] += v;
+                    h.count += v;
+                }
+                h.totalNs += b->totalNs[t].load(std::memory_order_relaxed);
+                uint64_t m = b->maxNs[t].load(std::memory_order_relaxed);
+                if (m > h.maxNs) h.maxNs = m;
+            }
+        }
+        return s;
+    }
+
+    /** Zero every buffer. Call while no thread is recording. */
+    static void reset() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        for (const std::unique_ptr<Buffer>& b : r.buffers) {
+            for (auto& v : b->counters) v.store(0, std::memory_order_relaxed);
+            for (auto& v : b->stacks) v.store(0, std::memory_order_relaxed);
+            for (auto& row : b->buckets) {
+                for (auto& v : row) v.store(0, std::memory_order_relaxed);
+            }
+            for (auto& v : b->totalNs) v.store(0, std::memory_order_relaxed);
+            for (auto& v : b->maxNs) v.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static bool enabled() {
+#ifdef UNO_INSTRUMENT
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /** Print the summary as a small text report. */
+    static void print(std::ostream& os) {
+        if (!enabled()) {
+            os << "Instrumentation is off (build with -DUNO_INSTRUMENT)" << std::endl;
+            return;
+        }
+        static const char* COUNTER_NAMES[COUNTER_COUNT] = {
+            "turns", "decisions", "draws", "forced draws", "penalty draws", "shuffles", "reshuffles"
+        };
+        static const char* TIMER_NAMES[TIMER_COUNT] = {
+            "turn", "decision", "effects", "shuffle", "draw"
+        };
+
+        Summary s = summary();
+        char line[160];
+        os << "Counters (" << s.threads << " threads)\n";
+        for (int c = 0; c < COUNTER_COUNT; c++) {
+            std::snprintf(line, sizeof(line), "  %-14s %14llu\n", COUNTER_NAMES[c],
+                          static_cast<unsigned long long>(s.counters[c]));
+            os << line;
+        }
+        os << "Plays by cards stacked\n";
+        for (int n = 0; n < STACK_SIZES; n++) {
+            std::snprintf(line, sizeof(line), "  %d%-13s %14llu\n", n + 1, n + 1 < STACK_SIZES ? "" : "+",
+                          static_cast<unsigned long long>(s.stacks[n]));
+            os << line;
+        }
+        std::snprintf(line, sizeof(line), "Latency (ns)  %14s %10s %10s %10s %10s\n",
+                      "count", "mean", "p50<=", "p99<=", "max");
+        os << line;
+        for (int t = 0; t < TIMER_COUNT; t++) {
+            const Histogram& h = s.timers[t];
+            std::snprintf(line, sizeof(line), "  %-11s %14llu %10.1f %10llu %10llu %10llu\n", TIMER_NAMES[t],
+                          static_cast<unsigned long long>(h.count), h.meanNs(),
+                          static_cast<unsigned long long>(h.percentileNs(0.50)),
+                          static_cast<unsigned long long>(h.percentileNs(0.99)),
+                          static_cast<unsigned long long>(h.maxNs));
+            os << line;
+        }
+        os.flush();
+    }
+};
+
+// --- Recording hooks ---
+
+#define UNO_INSTRUMENT_CONCAT2(a, b) a##b
+#define UNO_INSTRUMENT_CONCAT(a, b) UNO_INSTRUMENT_CONCAT2(a, b)
+
+#ifdef UNO_INSTRUMENT
+#define UNO_COUNT(counter) Instrument::count(Instrument::counter)
+#define UNO_COUNT_BY(counter, n) Instrument::count(Instrument::counter, static_cast<uint64_t>(n))
+#define UNO_STACK(n) Instrument::stack(n)
+#define UNO_TIMED(timer) \
+    Instrument::Scope UNO_INSTRUMENT_CONCAT(unoTimedScope, __LINE__)(Instrument::timer)
+#else
+#define UNO_COUNT(counter) ((void)0)
+#define UNO_COUNT_BY(counter, n) ((void)0)
+#define UNO_STACK(n) ((void)0)
+#define UNO_TIMED(timer) ((void)0)
+#endif
+
+#endif // INSTRUMENT_H
@@ -0,0 +1,466 @@
+#ifndef LARGETABLE_H
+#define LARGETABLE_H
+
+#include "Card.h"
+#include "GameEngine.h"
+#include "GameObserver.h"
+#include "Hand.h"
+#include "MultiDeck.h"
+#include "TurnRing.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief How many seats in play hold each hand size, kept up to date as
+ * hands change.
+ *
+ * A view can show the smallest hand, the seats on UNO and the cards held
+ * without walking the table. change() and remove() are O(1) except when
+ * the last seat at the smallest size grows: the smallest size then scans
+ * up to the next one in use, which costs no more than the cards that
+ * seat took, so it is O(1) amortized per card.
+ *
+ * @author Tuan
+ */
+class HandSizeIndex {
+private:
+    std::vector<uint32_t> bySize;   // seats in play with exactly s cards
+    int64_t cards;
+    int seats;
+    int smallest;
+
+    void raiseSmallest() {
+        if (seats == 0) {
+            smallest = 0;
+            return;
+        }
+        while (bySize[smallest] == 0) smallest++;
+    }
+
+public:
+    HandSizeIndex() : cards(0), seats(0), smallest(0) {}
+
+    /** count seats holding size cards each. */
+    void reset(int count, int size) {
+        bySize.assign(2 * size + 1, 0);
+        bySize[size] = count;
+        cards = static_cast<int64_t>(count) * size;
+        seats = count;
+        smallest = count > 0 ? size : 0;
+    }
+
+    /** A seat in play went from `from` cards to `to`. */
+    void change(int from, int to) {
+        if (from == to) return;
+        if (to >= static_cast<int>(bySize.size())) bySize.resize(2 * to + 1, 0);
+        bySize[from]--;
+        bySize[to]++;
+        cards += to - from;
+        if (to < smallest) {
+            smallest = to;
+        } else if (from == smallest && bySize[from] == 0) {
+            raiseSmallest();
+        }
+    }
+
+    /** A seat holding size cards left play. */
+    void remove(int size) {
+        bySize[size]--;
+        seats--;
+        cards -= size;
+        if (size == smallest && bySize[size] == 0) raiseSmallest();
+    }
+
+    int seatsInPlay() const { return seats; }
+    int smallestHand() const { return smallest; }
+    int64_t cardsHeld() const { return cards; }
+
+    /** Seats in play holding exactly size cards. */
+    int seatsWith(int size) const {
+        return size >= 0 && size < static_cast<int>(bySize.size()) ? static_cast<int>(bySize[size]) : 0;
+    }
+
+    size_t memoryBytes() const { return bySize.capacity() * sizeof(uint32_t); }
+};
+
+/**
+ * @brief UNO-Lite for tables of thousands of seats, played by greedy bots.
+ *
+ * GameEngine keeps its table in a flat GameState of at most ten seats and
+ * one deck, and its views look at every seat. LargeTable is built for
+ * stress and event runs instead:
+ *   - as many standard decks as the table needs (MultiDeck);
+ *   - turn order in a SeatRing: advance, reverse and removing a seat are
+ *     O(1), and skip-k never depends on the seat count;
+ *   - a seat that empties its hand leaves the ring and play goes on until
+ *     the configured number of seats are out (by default the first ends
+ *     the game, as in GameEngine);
+ *   - hand sizes are summarised incrementally (HandSizeIndex) for views.
+ *
+ * So each turn costs O(cards moved) whatever the size of the table. A
+ * seat is a Hand (64 bytes) plus about 13 bytes of turn order and finish
+ * order, so 10,000 seats with their 1,051 decks take about 1 MB.
+ *
+ * Seats play like GreedyPolicy, and with one deck, ten seats or fewer and
+ * the default places a game gives the same result as GameEngine with
+ * GreedyPolicy in every seat for the same seed.
+ *
+ * Observers get the GameObserver hooks plus onSeatOut().
+ *
+ * @author Tuan
+ */
+template <typename Observer = NullObserver>
+class LargeTable {
+public:
+    static constexpr int MIN_PLAYERS = StandardRules::MIN_PLAYERS;
+    static constexpr int DEFAULT_HAND_SIZE = StandardRules::HAND_SIZE;
+    static constexpr int DRAW_TWO_PENALTY = StandardRules::DRAW_TWO_PENALTY;
+    static constexpr int DEFAULT_MAX_TURNS = 100000000;
+    static const int MAX_COPIES = 255;   // Hand counts are one byte per kind
+
+private:
+    std::vector<Hand> hands;
+    std::vector<int32_t> finishOrder;   // seats in the order they went out
+    SeatRing order;
+    MultiDeck deck;
+    HandSizeIndex sizes;
+    std::vector<Card> played;           // scratch: the current play, lead first
+    Observer observer;
+    Card top;
+    int seats;
+    int decks;
+    int dealSize;
+    int places;
+    int maxTurns;
+    int turnCount;
+    bool over;
+
+    void give(Hand& hand, Card card) {
+        if (hand.count(card.kind()) >= MAX_COPIES) {
+            std::cerr << "give: a hand is full of " << card << "; card discarded" << std::endl;
+            deck.discard(card);
+            return;
+        }
+        hand.add(card);
+    }
+
+    void flipFirstCard() {
+        top = deck.drawFromDeck();
+        while (top.type() != NUMBER) {
+            deck.addCard(top);
+            deck.shuffle();
+            top = deck.drawFromDeck();
+        }
+        observer.onGameStart(*this);
+    }
+
+    /** Greedy choice: lowest playable kind, then every copy of every kind that stacks with it. */
+    void chooseCards(Hand& hand, uint64_t playable) {
+        int leadKind = __builtin_ctzll(playable);
+        Card lead = Card::fromKind(leadKind);
+        played.clear();
+        played.push_back(lead);
+        hand.removeKind(leadKind);
+        uint64_t stack = hand.stackKinds(lead);
+        while (stack) {
+            int k = __builtin_ctzll(stack);
+            for (int c = hand.count(k); c > 0; c--) {
+                played.push_back(Card::fromKind(k));
+                hand.removeKind(k);
+            }
+            stack &= stack - 1;
+        }
+    }
+
+    // Same effects as BasicGameEngine::applyStackedEffects, on the SeatRing
+    void applyStackedEffects(CardType type, int count) {
+        switch (type) {
+            case SKIP:
+                observer.onEffect(*this, type, count, -1, 0);
+                order.skip(count);
+                break;
+
+            case REVERSE:
+                observer.onEffect(*this, type, count, -1, 0);
+                if (count % 2 == 1) {
+                    order.reverse();
+                    if (order.size() == 2) order.advance();
+                }
+                break;
+
+            case DRAW_TWO: {
+                order.advance();
+                int victim = order.current();
+                Hand& hand = hands[victim];
+                int before = hand.size();
+                int drawn = 0;
+                for (int i = 0; i < DRAW_TWO_PENALTY * count && !deck.isEmpty(); i++) {
+                    give(hand, deck.drawFromDeck());
+                    drawn++;
+                }
+                sizes.change(before, hand.size());
+                observer.onEffect(*this, type, count, victim, drawn);
+                break;
+            }
+
+            case NUMBER:
+                break;
+        }
+    }
+
+    void endGame() {
+        over = true;
+        if (finishOrder.empty()) {
+            observer.onDraw(*this);
+        } else {
+            observer.onWinner(*this, finishOrder[0]);
+        }
+    }
+
+public:
+    /**
+     * A table of `seats` seats dealt handSize cards each from `decks`
+     * standard decks (0 = enough for the deal plus half again to draw).
+     */
+    explicit LargeTable(int seats, int decks = 0, int handSize = DEFAULT_HAND_SIZE)
+        : seats(seats), decks(decks), dealSize(handSize), places(1), maxTurns(DEFAULT_MAX_TURNS),
+          turnCount(0), over(true) {
+        if (this->seats < MIN_PLAYERS) {
+            std::cerr << "LargeTable: need at least " << MIN_PLAYERS << " seats" << std::endl;
+            this->seats = MIN_PLAYERS;
+        }
+        if (dealSize < 1) {
+            std::cerr << "LargeTable: hand size must be positive" << std::endl;
+            dealSize = DEFAULT_HAND_SIZE;
+        }
+        int needed = MultiDeck::decksFor(this->seats, dealSize);
+        if (this->decks <= 0) {
+            this->decks = needed;
+        } else if (static_cast<int64_t>(this->decks) * MultiDeck::CARDS_PER_DECK <=
+                   static_cast<int64_t>(this->seats) * dealSize) {
+            std::cerr << "LargeTable: " << this->decks << " decks cannot deal " << this->seats
+                      << " hands; using " << needed << std::endl;
+            this->decks = needed;
+        }
+        finishOrder.reserve(this->seats);
+    }
+
+    LargeTable(const LargeTable&) = delete;
+    LargeTable& operator=(const LargeTable&) = delete;
+
+    Observer& getObserver() { return observer; }
+    const Observer& getObserver() const { return observer; }
+
+    /** End a game as a draw after this many turns (0 = no limit). */
+    void setMaxTurns(int limit) { maxTurns = limit; }
+
+    /** End the game once n seats are out (clamped to seats - 1, so 0 plays to the last seat). */
+    void setPlaces(int n) { places = (n <= 0 || n >= seats) ? seats - 1 : n; }
+
+    /** Build, shuffle and deal a new game. */
+    void start(uint64_t seed) {
+        deck.seed(seed);
+        order.reset(seats);
+        hands.assign(seats, Hand());
+        finishOrder.clear();
+        turnCount = 0;
+        over = false;
+
+        deck.build(decks);
+        deck.shuffle();
+        for (Hand& hand : hands) {
+            for (int j = 0; j < dealSize; j++) {
+                if (!deck.isEmpty()) give(hand, deck.drawFromDeck());
+            }
+        }
+        sizes.reset(seats, dealSize);
+        flipFirstCard();
+    }
+
+    /** Play one turn. Returns false once the game is over. */
+    bool step() {
+        if (over) return false;
+        if (maxTurns > 0 && turnCount >= maxTurns) {
+            endGame();
+            return false;
+        }
+
+        int seat = order.current();
+        Hand& hand = hands[seat];
+        int before = hand.size();
+        turnCount++;
+        observer.onTurnStart(*this, seat);
+
+        uint64_t playable = hand.playableKinds(top);
+        if (playable != 0) {
+            chooseCards(hand, playable);
+        } else {
+            observer.onForcedDraw(*this, seat);
+            played.clear();
+            if (deck.isEmpty()) {
+                observer.onDeckEmpty(*this, seat);
+            } else {
+                Card drawn = deck.drawFromDeck();
+                observer.onCardDrawn(*this, seat, drawn);
+                give(hand, drawn);
+                if (drawn.isPlayable(top) && hand.remove(drawn)) played.push_back(drawn);
+            }
+        }
+
+        int n = static_cast<int>(played.size());
+        if (n > 0) {
+            deck.discard(top);
+            for (int i = 0; i + 1 < n; i++) deck.discard(played[i]);
+            top = played.back();
+            observer.onCardsPlayed(*this, seat, played.data(), n);
+            if (hand.size() == 1) observer.onUno(*this, seat);
+        }
+        sizes.change(before, hand.size());
+
+        if (n > 0 && hand.isEmpty()) {
+            finishOrder.push_back(seat);
+            sizes.remove(0);
+            observer.onSeatOut(*this, seat, static_cast<int>(finishOrder.size()));
+            if (static_cast<int>(finishOrder.size()) >= places || order.size() <= 2) {
+                order.remove(seat);
+                endGame();
+                return false;
+            }
+            // Effects first, while the seat still marks its place in the ring
+            applyStackedEffects(played[0].type(), n);
+            order.remove(seat);
+        } else if (n > 0) {
+            applyStackedEffects(played[0].type(), n);
+        }
+        order.advance();
+        return true;
+    }
+
+    void gameLoop() {
+        while (step()) {}
+    }
+
+    /** Play a whole game from a fresh deal. winner is the first seat out. */
+    GameResult runToCompletion(uint64_t seed) {
+        start(seed);
+        gameLoop();
+        return result();
+    }
+
+    /** First seat out (-1 if none yet) and turns played. */
+    GameResult result() const {
+        return GameResult{ finishOrder.empty() ? -1 : finishOrder[0], turnCount };
+    }
+
+    // --- Views (all O(1)) ---
+
+    bool isOver() const { return over; }
+    int turns() const { return turnCount; }
+    int seatCount() const { return seats; }
+    int seatsLeft() const { return order.size(); }
+    int deckCount() const { return decks; }
+    int currentSeat() const { return order.current(); }
+    int nextSeat() const { return order.peekNext(); }
+    const Card& topCard() const { return top; }
+    const Hand& hand(int seat) const { return hands[seat]; }
+    int handSize(int seat) const { return hands[seat].size(); }
+    const HandSizeIndex& handSizes() const { return sizes; }
+    const std::vector<int32_t>& finishers() const { return finishOrder; }
+    int deckSize() const { return deck.size(); }
+    int discardSize() const { return deck.discardSize(); }
+
+    /** Bytes used by the table, its decks and its indexes. */
+    size_t memoryBytes() const {
+        return sizeof(*this) + hands.capacity() * sizeof(Hand) + finishOrder.capacity() * sizeof(int32_t) +
+               order.memoryBytes() + deck.memoryBytes() + sizes.memoryBytes() + played.capacity() * sizeof(Card);
+    }
+};
+
+/**
+ * @brief Prints a LargeTable game one line per event.
+ *
+ * Each turn shows the summary views (seats left, smallest hand, seats on
+ * UNO, cards held) rather than every seat's hand size, so printing a turn
+ * costs the same at any table size.
+ *
+ * @author Tuan
+ */
+class LargeTableRenderer : public NullObserver {
+private:
+    std::ostream* out;
+
+public:
+    explicit LargeTableRenderer(std::ostream& stream = std::cout) : out(&stream) {}
+
+    void setStream(std::ostream& stream) { out = &stream; }
+
+    template <typename Table>
+    void onGameStart(const Table& table) {
+        *out << table.seatCount() << " seats, " << table.deckCount() << " decks. First card: "
+             << table.topCard() << '\n';
+    }
+
+    template <typename Table>
+    void onTurnStart(const Table& table, int seat) {
+        const HandSizeIndex& sizes = table.handSizes();
+        *out << "Turn " << table.turns() << ": Seat " << (seat + 1) << " (" << table.handSize(seat)
+             << " cards) on " << table.topCard() << " | next Seat " << (table.nextSeat() + 1) << " | "
+             << table.seatsLeft() << " left, smallest hand " << sizes.smallestHand() << ", "
+             << sizes.seatsWith(1) << " on UNO, " << sizes.cardsHeld() << " cards held, "
+             << table.deckSize() << " in deck\n";
+    }
+
+    template <typename Table>
+    void onCardDrawn(const Table&, int, Card card) {
+        *out << "  draws " << card << '\n';
+    }
+
+    template <typename Table>
+    void onDeckEmpty(const Table&, int) {
+        *out << "  deck is empty\n";
+    }
+
+    template <typename Table>
+    void onCardsPlayed(const Table&, int, const Card* cards, int count) {
+        *out << "  plays " << cards[0];
+        if (count > 1) *out << " + " << (count - 1) << " more, " << cards[count - 1] << " on top";
+        *out << '\n';
+    }
+
+    template <typename Table>
+    void onEffect(const Table&, CardType type, int count, int target, int drawn) {
+        switch (type) {
+            case SKIP:
+                *out << "  >> SKIP x" << count << '\n';
+                break;
+            case REVERSE:
+                *out << "  >> REVERSE x" << count << '\n';
+                break;
+            case DRAW_TWO:
+                *out << "  >> DRAW TWO x" << count << ": Seat " << (target + 1) << " draws " << drawn << '\n';
+                break;
+            case NUMBER:
+                break;
+        }
+    }
+
+    template <typename Table>
+    void onSeatOut(const Table&, int seat, int place) {
+        *out << "  Seat " << (seat + 1) << " is out in place " << place << '\n';
+    }
+
+    template <typename Table>
+    void onWinner(const Table& table, int seat) {
+        *out << "Game over after " << table.turns() << " turns; Seat " << (seat + 1) << " went out first.\n";
+        out->flush();
+    }
+
+    template <typename Table>
+    void onDraw(const Table& table) {
+        *out << "Turn limit reached after " << table.turns() << " turns; nobody went out.\n";
+        out->flush();
+    }
+};
+
+#endif // LARGETABLE_H
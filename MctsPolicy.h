@@ -0,0 +1,412 @@
+#ifndef MCTSPOLICY_H
+#define MCTSPOLICY_H
+
+#include "BeliefTracker.h"
+#include "GameEngine.h"
+#include "GameState.h"
+#include "MoveGen.h"
+#include "PlayerPolicy.h"
+#include "Random.h"
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Search budget and tuning for MctsPolicy.
+ * @author Tuan
+ */
+struct MctsConfig {
+    int iterations;       // playouts per decision, over all threads (0 = no limit)
+    int timeLimitMs;      // wall-clock budget per decision (0 = no limit)
+    int threads;          // search threads, including the caller's
+    double exploration;   // UCB1 exploration constant
+    int rolloutTurns;     // playouts still running after this many turns count as draws
+
+    MctsConfig()
+        : iterations(2000), timeLimitMs(0), threads(1), exploration(0.7), rolloutTurns(200) {}
+};
+
+/**
+ * @brief Computer player using information-set Monte-Carlo Tree Search.
+ *
+ * Each iteration deals the cards the seat cannot see (opponents' hands and
+ * the draw pile) at random, consistent with its own hand, the top card and
+ * the discard pile, then walks one shared tree over that deal (single
+ * observer IS-MCTS): children are plays, a child is only eligible when its
+ * play is legal in the current deal, and UCB1 uses how often it was
+ * available. Every seat in the tree maximises its own win rate. After one
+ * new node the game is played out by a cheap random stacking bot.
+ *
+ * All moves are applied by a real GameEngine restored from the sampled
+ * GameState, so the rules (stacked effects, the two-player Reverse, draw
+ * penalties) are exactly those of the game.
+ *
+ * With a BeliefTracker attached (setBeliefs), deals also respect what the
+ * public events show about each hand, e.g. that a seat which had to draw
+ * held nothing playable on the top card of the time.
+ *
+ * Moves come from MoveList: every distinct stacked play plus drawing.
+ *
+ * Threads search independent trees (root parallelism) and the root visit
+ * counts are summed. The threads live as long as the policy. With an
+ * iteration budget and a fixed seed the choice is reproducible.
+ *
+ * @author Tuan
+ */
+class MctsPolicy : public PlayerPolicy {
+private:
+    /** Seat policy inside the search: plays a scripted move, or rolls out. */
+    class SearchDriver : public PlayerPolicy {
+    public:
+        const Play* scripted;
+        Xoshiro256 rng;
+
+        SearchDriver() : scripted(nullptr) {}
+
+        void chooseCards(const GameState& state, int seat, std::vector<int>& indices) override {
+            const Hand& hand = state.players[seat].hand;
+            indices.clear();
+            if (scripted != nullptr) {
+                scripted->toIndices(hand, indices);
+                return;
+            }
+
+            // Rollout: random playable kind, stacked with every matching card
+            uint64_t playable = hand.playableKinds(state.topCard);
+            if (playable == 0) return;
+            uint32_t pick = rng.bounded(static_cast<uint32_t>(__builtin_popcountll(playable)));
+            while (pick-- > 0) playable &= playable - 1;
+            int leadKind = __builtin_ctzll(playable);
+            int lead = hand.indexOf(leadKind);
+            indices.push_back(lead);
+
+            uint64_t stack = hand.stackKinds(Card::fromKind(leadKind));
+            while (stack) {
+                int k = __builtin_ctzll(stack);
+                int first = hand.indexOf(k);
+                for (int c = 0; c < hand.count(k); c++) {
+                    if (first + c != lead) indices.push_back(first + c);
+                }
+                stack &= stack - 1;
+            }
+        }
+
+        bool playDrawnCard(const GameState&, int, const Card&) override { return true; }
+    };
+
+    struct TreeNode {
+        Play move;           // play that leads here from the parent
+        int seat;            // seat that made it
+        int parent;
+        int firstChild;
+        int nextSibling;
+        uint32_t visits;
+        uint32_t available;  // times the parent was visited with this move legal
+        double reward;       // wins of seat through this node
+    };
+
+    /** Per-thread search state, on its own cache lines. */
+    struct alignas(64) SearchWorker {
+        std::unique_ptr<GameEngine> engine;
+        SearchDriver driver;
+        Xoshiro256 rng;
+        GameState world;                // current determinization
+        std::vector<TreeNode> tree;
+        MoveList moves;                 // scratch: legal moves at a node
+        std::vector<char> tried;
+        uint64_t playouts;
+    };
+
+    MctsConfig config;
+    Xoshiro256 rng;
+    std::vector<std::unique_ptr<SearchWorker>> workers;
+    const BeliefTracker* beliefs;   // not owned; nullptr = deal uniformly
+
+    // Current search, read by every worker
+    const GameState* root;
+    int rootSeat;
+    std::chrono::steady_clock::time_point deadline;
+
+    // Thread pool: workers[0] runs on the caller, the rest on pool threads
+    std::vector<std::thread> pool;
+    std::mutex poolLock;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    uint64_t generation;
+    int running;
+    bool stopping;
+
+    // --- Search ---
+
+    /** Deal the cards rootSeat cannot see into w.world at random. */
+    void determinize(SearchWorker& w) {
+        GameState& world = w.world;
+        world = *root;
+        if (beliefs != nullptr) {
+            beliefs->determinize(world, rootSeat, w.rng);
+            world.deck.seed(w.rng());
+            return;
+        }
+
+        int unseen[Card::NUM_KINDS];
+        const Hand& own = root->players[rootSeat].hand;
+        for (int k = 0; k < Card::NUM_KINDS; k++) unseen[k] = root->deck.copiesOf(k) - own.count(k);
+        unseen[root->topCard.kind()]--;
+        for (int i = 0; i < root->deck.discardSize(); i++) unseen[root->deck.discardAt(i).kind()]--;
+
+        Card hidden[Deck::CAPACITY];
+        int n = 0;
+        for (int k = 0; k < Card::NUM_KINDS; k++) {
+            for (int c = 0; c < unseen[k] && n < Deck::CAPACITY; c++) hidden[n++] = Card::fromKind(k);
+        }
+        for (int i = n - 1; i > 0; i--) {
+            std::swap(hidden[i], hidden[w.rng.bounded(static_cast<uint32_t>(i + 1))]);
+        }
+
+        int pos = 0;
+        for (int seat = 0; seat < world.numPlayers; seat++) {
+            if (seat == rootSeat) continue;
+            Hand& hand = world.players[seat].hand;
+            int size = hand.size();
+            hand.clear();
+            for (int i = 0; i < size && pos < n; i++) hand.add(hidden[pos++]);
+        }
+        world.deck.replaceDrawPile(hidden + pos, n - pos);
+        world.deck.seed(w.rng());
+    }
+
+    void playMove(SearchWorker& w, const Play& move) {
+        w.driver.scripted = &move;
+        w.engine->step();
+        w.driver.scripted = nullptr;
+    }
+
+    void iterate(SearchWorker& w) {
+        determinize(w);
+        GameEngine& engine = *w.engine;
+        engine.restore(w.world);
+
+        // Selection and expansion
+        int node = 0;
+        while (!engine.isOver()) {
+            int seat = engine.currentSeat();
+            w.moves.generate(engine.player(seat).hand, engine.topCard());
+            w.tried.assign(w.moves.size(), 0);
+
+            int best = -1;
+            double bestScore = -1.0;
+            for (int c = w.tree[node].firstChild; c >= 0; c = w.tree[c].nextSibling) {
+                TreeNode& child = w.tree[c];
+                // After a draw, who moves next depends on the card dealt, so a
+                // child is keyed by its seat as well as its move
+                if (child.seat != seat) continue;
+                int i = w.moves.find(child.move);
+                if (i < 0) continue;
+                w.tried[i] = 1;
+                child.available++;
+                double score = child.reward / child.visits +
+                               config.exploration * std::sqrt(std::log(static_cast<double>(child.available)) / child.visits);
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = c;
+                }
+            }
+
+            int untried = 0;
+            for (char t : w.tried) untried += (t == 0);
+            if (untried > 0) {
+                uint32_t pick = w.rng.bounded(static_cast<uint32_t>(untried));
+                int i = 0;
+                while (w.tried[i] || pick-- > 0) i++;
+
+                TreeNode child;
+                child.move = w.moves[i];
+                child.seat = seat;
+                child.parent = node;
+                child.firstChild = -1;
+                child.nextSibling = w.tree[node].firstChild;
+                child.visits = 0;
+                child.available = 1;
+                child.reward = 0.0;
+                w.tree.push_back(child);
+                node = static_cast<int>(w.tree.size()) - 1;
+                w.tree[child.parent].firstChild = node;
+                playMove(w, child.move);
+                break;
+            }
+
+            node = best;
+            Play move = w.tree[node].move;
+            playMove(w, move);
+        }
+
+        // Rollout
+        while (engine.step()) {}
+
+        // Backpropagation
+        int winner = engine.winner();
+        double drawShare = 1.0 / engine.playerCount();
+        for (int n = node; n >= 0; n = w.tree[n].parent) {
+            TreeNode& t = w.tree[n];
+            t.visits++;
+            if (t.seat >= 0) t.reward += (winner < 0) ? drawShare : (winner == t.seat ? 1.0 : 0.0);
+        }
+        w.playouts++;
+    }
+
+    void search(SearchWorker& w, int budget) {
+        w.tree.clear();
+        TreeNode top;
+        top.move = Play();
+        top.seat = -1;
+        top.parent = -1;
+        top.firstChild = -1;
+        top.nextSibling = -1;
+        top.visits = 0;
+        top.available = 0;
+        top.reward = 0.0;
+        w.tree.push_back(top);
+        w.playouts = 0;
+
+        if (!w.engine || w.engine->playerCount() != root->numPlayers) {
+            w.engine.reset(new GameEngine());
+            for (int seat = 0; seat < root->numPlayers; seat++) {
+                w.engine->addPlayer("search", &w.driver);
+            }
+        }
+        w.engine->setMaxTurns(root->turnCount + config.rolloutTurns);
+
+        for (int i = 0; budget == 0 || i < budget; i++) {
+            if (config.timeLimitMs > 0 && (i & 31) == 0 &&
+                std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+            iterate(w);
+        }
+    }
+    void poolLoop(int index) {
+        uint64_t seen = 0;
+        while (true) {
+            int budget;
+            {
+                std::unique_lock<std::mutex> guard(poolLock);
+                wake.wait(guard, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                budget = workerBudget(index);
+            }
+            search(*workers[index], budget);
+            {
+                std::lock_guard<std::mutex> guard(poolLock);
+                if (--running == 0) finished.notify_one();
+            }
+        }
+    }
+
+    /** Share of the iteration budget for worker index (0 = unlimited). */
+    int workerBudget(int index) const {
+        if (config.iterations <= 0) return 0;
+        int n = static_cast<int>(workers.size());
+        int share = config.iterations / n + (index < config.iterations % n ? 1 : 0);
+        return share > 0 ? share : 1;
+    }
+
+    /** Search from state for seat and return the most visited root move. */
+    Play bestMove(const GameState& state, int seat) {
+        root = &state;
+        rootSeat = seat;
+        deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(config.timeLimitMs);
+
+        uint64_t base = rng();
+        for (size_t i = 0; i < workers.size(); i++) {
+            workers[i]->rng.seed(streamSeed(base, 2 * i));
+            workers[i]->driver.rng.seed(streamSeed(base, 2 * i + 1));
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(poolLock);
+            running = static_cast<int>(pool.size());
+            generation++;
+        }
+        wake.notify_all();
+        search(*workers[0], workerBudget(0));
+        {
+            std::unique_lock<std::mutex> guard(poolLock);
+            finished.wait(guard, [&] { return running == 0; });
+        }
+
+        // Sum root visits over every worker's tree
+        MoveList& moves = workers[0]->moves;
+        moves.generate(state.players[seat].hand, state.topCard);
+        std::vector<uint64_t> visits(moves.size(), 0);
+        for (const auto& w : workers) {
+            for (int c = w->tree[0].firstChild; c >= 0; c = w->tree[c].nextSibling) {
+                int i = moves.find(w->tree[c].move);
+                if (i >= 0) visits[i] += w->tree[c].visits;
+            }
+        }
+        size_t best = 0;
+        for (size_t i = 1; i < visits.size(); i++) {
+            if (visits[i] > visits[best]) best = i;
+        }
+        return moves[static_cast<int>(best)];
+    }
+
+public:
+    explicit MctsPolicy(const MctsConfig& config = MctsConfig(), uint64_t seed = 0)
+        : config(config), rng(seed), beliefs(nullptr), root(nullptr), rootSeat(-1),
+          generation(0), running(0), stopping(false) {
+        if (this->config.iterations <= 0 && this->config.timeLimitMs <= 0) {
+            std::cerr << "MctsPolicy: no search budget, using "
+                      << MctsConfig().iterations << " iterations" << std::endl;
+            this->config.iterations = MctsConfig().iterations;
+        }
+        int threads = this->config.threads > 0 ? this->config.threads : 1;
+        for (int i = 0; i < threads; i++) workers.emplace_back(new SearchWorker());
+        for (int i = 1; i < threads; i++) pool.emplace_back(&MctsPolicy::poolLoop, this, i);
+    }
+
+    ~MctsPolicy() {
+        {
+            std::lock_guard<std::mutex> guard(poolLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : pool) t.join();
+    }
+
+    MctsPolicy(const MctsPolicy&) = delete;
+    MctsPolicy& operator=(const MctsPolicy&) = delete;
+
+    void newGame(uint64_t seed) override { rng.seed(seed); }
+
+    /**
+     * Deal searches from a tracker fed by the engine this policy plays in
+     * (nullptr to deal uniformly). The tracker is not owned and is only
+     * read while a decision is being made.
+     */
+    void setBeliefs(const BeliefTracker* tracker) { beliefs = tracker; }
+
+    void chooseCards(const GameState& state, int seat, std::vector<int>& indices) override {
+        Play move = bestMove(state, seat);
+        move.toIndices(state.players[seat].hand, indices);
+    }
+
+    /** A playable drawn card is always played; keeping it is rarely better. */
+    bool playDrawnCard(const GameState&, int, const Card&) override { return true; }
+
+    /** Playouts run for the last decision, over all threads. */
+    uint64_t lastPlayouts() const {
+        uint64_t total = 0;
+        for (const auto& w : workers) total += w->playouts;
+        return total;
+    }
+};
+
+#endif // MCTSPOLICY_H
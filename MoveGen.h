@@ -0,0 +1,234 @@
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "Card.h"
+#include "Hand.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief One legal play: some copies of one rank, a lead and a top card.
+ *
+ * cards is a bitmask with one byte per color: bit 8 * color + i means the
+ * (i+1)-th copy of kind color * 13 + rank is played. Copies are always
+ * taken lowest first. The lead is played first and must be playable; the
+ * card of color last ends on top. count == 0 means draw instead.
+ *
+ * variants counts the selections that the rules treat the same as this
+ * one: the same cards and top card with another playable lead, or other
+ * copies of identical cards. Only one of them is listed.
+ *
+ * @author Tam
+ */
+struct Play {
+    static const int COPY_BITS = 8;   // copies of one kind a play can hold
+
+    uint32_t cards;
+    uint8_t rank;
+    uint8_t lead;      // color of the lead card
+    uint8_t last;      // color of the card left on top
+    uint8_t count;
+    uint32_t variants;
+
+    bool isDraw() const { return count == 0; }
+
+    /** Copies of color c in this play. */
+    int copies(int color) const {
+        return __builtin_popcount((cards >> (COPY_BITS * color)) & 0xFF);
+    }
+
+    Card leadCard() const { return Card::fromKind(lead * Card::KINDS_PER_COLOR + rank); }
+    Card topCard() const { return Card::fromKind(last * Card::KINDS_PER_COLOR + rank); }
+
+    /** Same outcome: same cards leave the hand and the same card ends on top. */
+    bool operator==(const Play& other) const {
+        return count == other.count && (count == 0 ||
+               (cards == other.cards && rank == other.rank && last == other.last));
+    }
+    bool operator!=(const Play& other) const { return !(*this == other); }
+
+    /**
+     * Hand indices for the engine, lead first and top card last. Assumes
+     * the hand is the one the play was generated from.
+     */
+    int toIndices(const Hand& hand, int* out) const {
+        if (count == 0) return 0;
+        int n = 0;
+        const int K = Card::KINDS_PER_COLOR;
+        out[n++] = hand.indexOf(lead * K + rank);
+        for (int c = 0; c < 4; c++) {
+            int middle = copies(c) - (c == lead ? 1 : 0) - (c == last ? 1 : 0);
+            int first = hand.indexOf(c * K + rank) + (c == lead ? 1 : 0);
+            for (int i = 0; i < middle; i++) out[n++] = first + i;
+        }
+        if (count > 1) {
+            out[n++] = hand.indexOf(last * K + rank) + copies(last) - 1;
+        }
+        return n;
+    }
+
+    void toIndices(const Hand& hand, std::vector<int>& out) const {
+        int buffer[4 * COPY_BITS];
+        int n = toIndices(hand, buffer);
+        out.assign(buffer, buffer + n);
+    }
+
+    /**
+     * The play a selection of hand indices makes (lead first), to compare
+     * with a MoveList entry. Assumes the selection is valid; an empty one
+     * is a draw.
+     */
+    static Play fromIndices(const Hand& hand, const std::vector<int>& indices) {
+        Play play = Play();
+        if (indices.empty()) return play;
+        int taken[4] = { 0, 0, 0, 0 };
+        for (int idx : indices) {
+            Card card = hand.get(idx);
+            if (taken[card.color()] < COPY_BITS) taken[card.color()]++;
+        }
+        Card lead = hand.get(indices.front());
+        play.rank = static_cast<uint8_t>(lead.kind() % Card::KINDS_PER_COLOR);
+        play.lead = static_cast<uint8_t>(lead.color());
+        play.last = static_cast<uint8_t>(hand.get(indices.back()).color());
+        for (int c = 0; c < 4; c++) {
+            play.cards |= ((1u << taken[c]) - 1) << (COPY_BITS * c);
+        }
+        play.count = static_cast<uint8_t>(indices.size());
+        play.variants = 1;
+        return play;
+    }
+};
+
+/**
+ * @brief Fixed-capacity list of every legal play from a hand.
+ *
+ * generate() walks the playable kinds of the hand once. For each playable
+ * rank it enumerates the copies to take per color as bitmask subsets,
+ * every color that can end on top and a playable lead, writing into a
+ * preallocated array, so generating never allocates. Selections with the
+ * same outcome are collapsed into one Play (see Play::variants). Drawing
+ * is listed last and is the only move when nothing is playable.
+ *
+ * A hand rarely has more than a few dozen plays; if the list ever fills,
+ * the rest are dropped and truncated() is set.
+ *
+ * @author Tam
+ */
+class MoveList {
+public:
+    static const int CAPACITY = 1024;
+
+private:
+    Play plays[CAPACITY];
+    int count;
+    bool overflow;
+
+    static int choose(int n, int k) {
+        int r = 1;
+        for (int i = 1; i <= k; i++) r = r * (n - k + i) / i;
+        return r;
+    }
+
+    void push(const Play& play) {
+        if (count >= CAPACITY) {
+            overflow = true;
+            return;
+        }
+        plays[count++] = play;
+    }
+
+    void addRank(const Hand& hand, uint64_t playableKinds, int rank) {
+        const int K = Card::KINDS_PER_COLOR;
+        int avail[4];
+        bool playable[4];
+        for (int c = 0; c < 4; c++) {
+            avail[c] = hand.count(c * K + rank);
+            if (avail[c] > Play::COPY_BITS) avail[c] = Play::COPY_BITS;
+            playable[c] = (playableKinds >> (c * K + rank)) & 1;
+        }
+
+        // Odometer over copies taken per color: t[c] in 0..avail[c]
+        int t[4] = { 0, 0, 0, 0 };
+        while (true) {
+            int c = 0;
+            while (c < 4 && t[c] == avail[c]) t[c++] = 0;
+            if (c == 4) break;
+            t[c]++;
+
+            int n = t[0] + t[1] + t[2] + t[3];
+            uint32_t mask = 0;
+            int copyVariants = 1;
+            for (int i = 0; i < 4; i++) {
+                mask |= ((1u << t[i]) - 1) << (Play::COPY_BITS * i);
+                copyVariants *= choose(avail[i], t[i]);
+            }
+
+            for (int last = 0; last < 4; last++) {
+                if (t[last] == 0) continue;
+
+                // Leads: playable colors with a card left once last is set aside
+                int lead = -1;
+                int leads = 0;
+                for (int i = 0; i < 4; i++) {
+                    int left = (n == 1) ? t[i] : t[i] - (i == last ? 1 : 0);
+                    if (left > 0 && playable[i]) {
+                        if (lead < 0) lead = i;
+                        leads++;
+                    }
+                }
+                if (lead < 0) continue;
+
+                Play play;
+                play.cards = mask;
+                play.rank = static_cast<uint8_t>(rank);
+                play.lead = static_cast<uint8_t>(lead);
+                play.last = static_cast<uint8_t>(last);
+                play.count = static_cast<uint8_t>(n);
+                play.variants = static_cast<uint32_t>(copyVariants * leads);
+                push(play);
+            }
+        }
+    }
+
+public:
+    MoveList() : count(0), overflow(false) {}
+
+    /** Fill the list with every legal play from hand on top, then draw. */
+    void generate(const Hand& hand, const Card& top) {
+        count = 0;
+        overflow = false;
+        uint64_t playable = hand.playableKinds(top);
+        uint32_t ranksDone = 0;
+        while (playable) {
+            int rank = __builtin_ctzll(playable) % Card::KINDS_PER_COLOR;
+            playable &= playable - 1;
+            if (ranksDone & (1u << rank)) continue;
+            ranksDone |= 1u << rank;
+            addRank(hand, hand.playableKinds(top), rank);
+        }
+
+        Play draw = Play();
+        push(draw);
+        if (overflow) {
+            std::cerr << "generate: more than " << CAPACITY << " plays, list truncated" << std::endl;
+            plays[CAPACITY - 1] = draw;
+        }
+    }
+
+    int size() const { return count; }
+    bool truncated() const { return overflow; }
+    const Play& operator[](int i) const { return plays[i]; }
+    const Play* begin() const { return plays; }
+    const Play* end() const { return plays + count; }
+
+    /** Index of a play with the same outcome, or -1. */
+    int find(const Play& play) const {
+        for (int i = 0; i < count; i++) {
+            if (plays[i] == play) return i;
+        }
+        return -1;
+    }
+};
+
+#endif // MOVEGEN_H
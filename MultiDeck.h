@@ -0,0 +1,120 @@
+#ifndef MULTIDECK_H
+#define MULTIDECK_H
+
+#include "Card.h"
+#include "Deck.h"
+#include "Random.h"
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Draw and discard piles holding any number of standard decks.
+ *
+ * Works like Deck (lazy Fisher-Yates shuffle, discard pile recycled by
+ * swapping the two piles) but the piles are vectors sized for all the
+ * decks at build time, for tables too big for one 100-card Deck. Each
+ * deck is added in the same order Deck::build() uses, so a one-deck
+ * MultiDeck draws exactly the cards a Deck with the same seed draws.
+ *
+ * @author Tam
+ */
+class MultiDeck {
+public:
+    static const int CARDS_PER_DECK = Deck::CAPACITY;
+
+private:
+    std::vector<Card> piles[2];
+    Xoshiro256 rng;
+    int decks;
+    uint8_t drawPile;   // index of the draw pile in piles; the other is the discard pile
+    bool randomDraws;   // set by shuffle(): draw a random remaining card
+
+    std::vector<Card>& cards() { return piles[drawPile]; }
+
+public:
+    MultiDeck() : decks(0), drawPile(0), randomDraws(false) {}
+
+    /** Decks needed to deal handSize cards to each seat with half as many again left to draw. */
+    static int decksFor(int seats, int handSize) {
+        int64_t needed = static_cast<int64_t>(seats) * handSize * 3 / 2 + 1;
+        return static_cast<int>((needed + CARDS_PER_DECK - 1) / CARDS_PER_DECK);
+    }
+
+    /** Reseed the generator. */
+    void seed(uint64_t value) { rng.seed(value); }
+
+    /** Build count standard decks into the draw pile. Both piles get room for every card. */
+    void build(int count) {
+        if (count < 1) {
+            std::cerr << "build: need at least one deck, got " << count << std::endl;
+            count = 1;
+        }
+        decks = count;
+        drawPile = 0;
+        randomDraws = false;
+        for (std::vector<Card>& pile : piles) {
+            pile.clear();
+            pile.reserve(static_cast<size_t>(count) * CARDS_PER_DECK);
+        }
+        CardColor colors[] = { RED, BLUE, GREEN, YELLOW };
+        for (int d = 0; d < count; d++) {
+            for (CardColor color : colors) {
+                addCard(Card(color, 0, NUMBER));
+                for (int v = 1; v <= 9; v++) {
+                    addCard(Card(color, v, NUMBER));
+                    addCard(Card(color, v, NUMBER));
+                }
+                for (int i = 0; i < 2; i++) {
+                    addCard(Card(color, -1, SKIP));
+                    addCard(Card(color, -1, REVERSE));
+                    addCard(Card(color, -1, DRAW_TWO));
+                }
+            }
+        }
+    }
+
+    /** Shuffle lazily: O(1) now, one Fisher-Yates step per draw. */
+    void shuffle() { randomDraws = true; }
+
+    void addCard(Card card) { cards().push_back(card); }
+
+    /** Put a played card on the discard pile. */
+    void discard(Card card) { piles[drawPile ^ 1].push_back(card); }
+
+    /** Turn the discard pile into the draw pile. Returns false if it is empty. */
+    bool recycleDiscards() {
+        if (piles[drawPile ^ 1].empty()) return false;
+        cards().clear();
+        drawPile ^= 1;
+        shuffle();
+        return true;
+    }
+
+    Card drawFromDeck() {
+        if (cards().empty() && !recycleDiscards()) {
+            std::cerr << "drawFromDeck: deck is empty" << std::endl;
+            return Card();
+        }
+        std::vector<Card>& c = cards();
+        size_t n = c.size();
+        if (randomDraws) {
+            std::swap(c[rng.bounded(static_cast<uint32_t>(n))], c[n - 1]);
+        }
+        Card card = c.back();
+        c.pop_back();
+        return card;
+    }
+
+    /** True when neither the draw pile nor the discard pile has a card. */
+    bool isEmpty() const { return piles[0].empty() && piles[1].empty(); }
+    int size() const { return static_cast<int>(piles[drawPile].size()); }
+    int discardSize() const { return static_cast<int>(piles[drawPile ^ 1].size()); }
+    int deckCount() const { return decks; }
+
+    /** Heap bytes held by the piles. */
+    size_t memoryBytes() const { return (piles[0].capacity() + piles[1].capacity()) * sizeof(Card); }
+};
+
+#endif // MULTIDECK_H
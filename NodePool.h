@@ -0,0 +1,144 @@
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include "Node.h"
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief Node allocator that uses plain new/delete.
+ * @tparam T The data type stored in the node.
+ * @author Khang
+ */
+template <typename T>
+struct HeapNodeAllocator {
+    static Node<T>* create(const T& value) { return new Node<T>(value); }
+
+    static void destroy(Node<T>* node) { delete node; }
+
+    /** Free the chain head..tail (linked through next). */
+    static void destroyChain(Node<T>* head, Node<T>* tail) {
+        tail->next = nullptr;
+        while (head != nullptr) {
+            Node<T>* next = head->next;
+            delete head;
+            head = next;
+        }
+    }
+};
+
+/**
+ * @brief Slab allocator with a per-thread free list of nodes.
+ *
+ * Nodes are carved out of fixed-size slabs and never returned to the
+ * heap. Released nodes go on the calling thread's free list, linked
+ * through their own next pointers, so a whole list can be handed back in
+ * O(1) by splicing its chain onto the free list. When a thread exits its
+ * free nodes move to a shared list that other threads pick up, so nodes
+ * are recycled across games and threads and a steady-state simulation
+ * does no heap allocation for nodes at all.
+ *
+ * @tparam T The data type stored in the node.
+ * @author Khang
+ */
+template <typename T>
+class NodePool {
+private:
+    static const int SLAB_SIZE = 256;
+
+    struct SharedList {
+        std::mutex lock;
+        Node<T>* head = nullptr;
+        Node<T>* tail = nullptr;
+    };
+
+    struct LocalList {
+        Node<T>* head = nullptr;
+        Node<T>* tail = nullptr;
+
+        ~LocalList() {
+            if (head == nullptr) return;
+            SharedList& shared = sharedList();
+            std::lock_guard<std::mutex> guard(shared.lock);
+            tail->next = shared.head;
+            if (shared.head == nullptr) shared.tail = tail;
+            shared.head = head;
+        }
+    };
+
+    static SharedList& sharedList() {
+        static SharedList shared;
+        return shared;
+    }
+
+    static LocalList& localList() {
+        thread_local LocalList local;
+        return local;
+    }
+
+    /** Refill an empty local list from the shared list, or from a new slab. */
+    static void refill(LocalList& local) {
+        SharedList& shared = sharedList();
+        {
+            std::lock_guard<std::mutex> guard(shared.lock);
+            if (shared.head != nullptr) {
+                local.head = shared.head;
+                local.tail = shared.tail;
+                shared.head = nullptr;
+                shared.tail = nullptr;
+                return;
+            }
+        }
+
+        void* raw = ::operator new(sizeof(Node<T>) * SLAB_SIZE);
+        Node<T>* slab = static_cast<Node<T>*>(raw);
+        for (int i = 0; i < SLAB_SIZE; i++) {
+            new (&slab[i]) Node<T>(T());
+            slab[i].next = (i + 1 < SLAB_SIZE) ? &slab[i + 1] : nullptr;
+        }
+        local.head = &slab[0];
+        local.tail = &slab[SLAB_SIZE - 1];
+    }
+
+public:
+    static Node<T>* create(const T& value) {
+        LocalList& local = localList();
+        if (local.head == nullptr) refill(local);
+
+        Node<T>* node = local.head;
+        local.head = node->next;
+        if (local.head == nullptr) local.tail = nullptr;
+
+        node->data = value;
+        node->next = nullptr;
+        return node;
+    }
+
+    static void destroy(Node<T>* node) {
+        if (!std::is_trivially_destructible<T>::value) node->data = T();
+
+        LocalList& local = localList();
+        node->next = local.head;
+        if (local.head == nullptr) local.tail = node;
+        local.head = node;
+    }
+
+    /**
+     * Return the chain head..tail (linked through next) to the free list.
+     * O(1) for trivially destructible T; otherwise each element is reset.
+     */
+    static void destroyChain(Node<T>* head, Node<T>* tail) {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (Node<T>* n = head; n != tail; n = n->next) n->data = T();
+            tail->data = T();
+        }
+
+        LocalList& local = localList();
+        tail->next = local.head;
+        if (local.head == nullptr) local.tail = tail;
+        local.head = head;
+    }
+};
+
+#endif // NODEPOOL_H
@@ -2,24 +2,27 @@
 #define PLAYER_H
 
 #include "Card.h"
-#include "CircularLinkedList.h"
+#include "Hand.h"
 #include <iostream>
-#include <string>
 
 /**
- * @brief Represents a player with a name and a hand of cards.
+ * @brief Represents a player's seat and hand of cards.
+ *
+ * Names are kept by the engine, so a Player is plain data and a whole
+ * table of them can be copied as part of a GameState.
+ *
  * @author Tam
  */
 class Player {
 public:
-    std::string name;
-    CircularLinkedList<Card> hand;
+    Hand hand;
+    int seat;
 
-    Player() : name("Unknown") {}
-    explicit Player(const std::string& name) : name(name) {}
+    Player() : seat(-1) {}
+    explicit Player(int seat) : seat(seat) {}
 
     void drawCard(Card card) {
-        hand.insertBack(card);
+        hand.add(card);
     }
 
     Card playCard(int index) {
@@ -29,15 +32,13 @@ public:
     }
 
     bool hasPlayableCard(const Card& topCard) const {
-        for (int i = 0; i < hand.size(); i++) {
-            if (hand.get(i).isPlayable(topCard)) return true;
-        }
-        return false;
+        return hand.hasPlayable(topCard);
     }
 
-    void showHand() const {
-        for (int i = 0; i < hand.size(); i++) {
-            std::cout << "  " << i << ": " << hand.get(i) << std::endl;
+    void showHand(std::ostream& os = std::cout) const {
+        int index = 0;
+        for (Card card : hand) {
+            os << "  " << index++ << ": " << card << std::endl;
         }
     }
 
@@ -0,0 +1,42 @@
+#ifndef PLAYERPOLICY_H
+#define PLAYERPOLICY_H
+
+#include "Card.h"
+#include "GameState.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Decision interface for a seat at the table.
+ *
+ * The engine asks the policy every time the seat has to choose something.
+ * Humans, bots and scripted players all implement this interface.
+ *
+ * Each call gets the whole table as a GameState so lookahead players can
+ * copy it and search. A fair policy reads only its own hand
+ * (state.players[seat]) and public information: the top card, hand
+ * sizes, pile sizes and the turn order.
+ *
+ * @author Tuan
+ */
+class PlayerPolicy {
+public:
+    virtual ~PlayerPolicy() {}
+
+    /** Called once per seat when a new game starts; bots reseed from it. */
+    virtual void newGame(uint64_t seed) { (void)seed; }
+
+    /**
+     * Choose the hand indices to play this turn: fill indices (it arrives
+     * holding the last answer) with the lead card first and the rest
+     * stacked on it, or leave it empty to draw. The caller owns and reuses
+     * the buffer, so a policy that only clears and appends never allocates
+     * once its capacity has grown.
+     */
+    virtual void chooseCards(const GameState& state, int seat, std::vector<int>& indices) = 0;
+
+    /** After a forced draw, decide whether to play the drawn (playable) card. */
+    virtual bool playDrawnCard(const GameState& state, int seat, const Card& drawn) = 0;
+};
+
+#endif // PLAYERPOLICY_H
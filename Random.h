@@ -0,0 +1,85 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/**
+ * @brief Random number helpers for reproducible simulation.
+ *
+ * Every game gets its own stream seeded from (master seed, game index),
+ * so the result of a game never depends on which thread ran it.
+ *
+ * @author Tuan
+ */
+
+/** SplitMix64 step: advance the state and return the next output. */
+inline uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/** Seed of stream `index` derived from a master seed. */
+inline uint64_t streamSeed(uint64_t master, uint64_t index) {
+    uint64_t state = master ^ (index * 0xD1B54A32D192ED03ULL);
+    splitmix64(state);
+    return splitmix64(state);
+}
+
+/**
+ * @brief xoshiro256** generator: small, fast and seedable.
+ *
+ * Meets the UniformRandomBitGenerator requirements, and bounded() gives
+ * unbiased integers in [0, n) without a division in the common case
+ * (Lemire's multiply-and-reject method).
+ *
+ * @author Tuan
+ */
+class Xoshiro256 {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+    /** Fill the state from SplitMix64 so any seed (even 0) is usable. */
+    void seed(uint64_t value) {
+        for (int i = 0; i < 4; i++) s[i] = splitmix64(value);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~0ULL; }
+
+    result_type operator()() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    /** Uniform integer in [0, n) for n > 0. */
+    uint32_t bounded(uint32_t n) {
+        uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * n;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < n) {
+            uint32_t threshold = static_cast<uint32_t>(-n) % n;
+            while (low < threshold) {
+                m = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * n;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+};
+
+#endif // RANDOM_H
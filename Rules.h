@@ -0,0 +1,118 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include "Deck.h"
+#include "GameState.h"
+#include <ostream>
+#include <string>
+
+/**
+ * @brief The house rules of UNO-Lite, as compile-time constants.
+ *
+ * BasicGameEngine takes a rules class as a template parameter and tests
+ * these with `if constexpr`, so each variant compiles to its own engine
+ * with no rule checks left on the hot path. A variant derives from
+ * StandardRules and redefines what it changes.
+ *
+ * @author Tuan
+ */
+struct StandardRules {
+    static constexpr const char* NAME = "standard";
+    static constexpr const char* DESCRIPTION = "7 cards, same-rank cards stack, draw one card";
+
+    static constexpr int HAND_SIZE = 7;
+    static constexpr int MIN_PLAYERS = 2;
+    static constexpr int MAX_PLAYERS = GameState::MAX_PLAYERS;
+    static constexpr int DRAW_TWO_PENALTY = 2;
+
+    // Deck: per color one 0, NUMBER_COPIES of 1..MAX_NUMBER, ACTION_COPIES of each action
+    static constexpr int MAX_NUMBER = 9;
+    static constexpr int ZERO_COPIES = 1;
+    static constexpr int NUMBER_COPIES = 2;
+    static constexpr int ACTION_COPIES = 2;
+
+    /** Several cards of the same number or action may be played at once. */
+    static constexpr bool STACKING = true;
+
+    /**
+     * A Draw Two victim holding a Draw Two may play it instead of drawing,
+     * passing the whole penalty on to the next seat.
+     */
+    static constexpr bool PENALTY_STACKING = false;
+
+    /** With nothing playable, keep drawing until a playable card turns up. */
+    static constexpr bool DRAW_UNTIL_PLAYABLE = false;
+};
+
+/** @brief One card per turn. */
+struct NoStackingRules : StandardRules {
+    static constexpr const char* NAME = "no-stacking";
+    static constexpr const char* DESCRIPTION = "only one card per turn";
+    static constexpr bool STACKING = false;
+};
+
+/** @brief Draw Two penalties pass along until someone cannot answer. */
+struct PenaltyStackingRules : StandardRules {
+    static constexpr const char* NAME = "penalty-stacking";
+    static constexpr const char* DESCRIPTION = "a Draw Two victim may answer with a Draw Two";
+    static constexpr bool PENALTY_STACKING = true;
+};
+
+/** @brief Forced draws continue until a playable card is found. */
+struct DrawUntilPlayableRules : StandardRules {
+    static constexpr const char* NAME = "draw-until-playable";
+    static constexpr const char* DESCRIPTION = "draw until a playable card turns up";
+    static constexpr bool DRAW_UNTIL_PLAYABLE = true;
+};
+
+/** @brief Quick games: 5 cards each from a deck of numbers 0-5 and actions. */
+struct ShortDeckRules : StandardRules {
+    static constexpr const char* NAME = "short-deck";
+    static constexpr const char* DESCRIPTION = "5 cards each, numbers 0-5 only (68-card deck)";
+    static constexpr int HAND_SIZE = 5;
+    static constexpr int MAX_NUMBER = 5;
+};
+
+/** Cards in the deck a rules class builds. */
+template <typename Rules>
+constexpr int cardsInDeck() {
+    return 4 * (Rules::ZERO_COPIES + Rules::MAX_NUMBER * Rules::NUMBER_COPIES + 3 * Rules::ACTION_COPIES);
+}
+
+/** Tag that carries a rules class through a generic lambda. */
+template <typename Rules>
+struct RulesTag {
+    typedef Rules type;
+};
+
+/**
+ * @brief Compile-time list of rule variants, looked up by name at run time.
+ *
+ * visit(name, f) calls f(RulesTag<R>()) for the variant named name, so
+ * the caller can instantiate its engine for that variant:
+ *
+ *   RulesRegistry::visit("no-stacking", [&](auto tag) {
+ *       using R = typename decltype(tag)::type;
+ *       BasicGameEngine<NullObserver, R> engine;
+ *       ...
+ *   });
+ *
+ * @author Tuan
+ */
+template <typename... Variants>
+struct RulesList {
+    /** Returns false if no variant has that name. */
+    template <typename Visitor>
+    static bool visit(const std::string& name, Visitor&& visitor) {
+        return ((name == Variants::NAME ? (visitor(RulesTag<Variants>()), true) : false) || ...);
+    }
+
+    static void list(std::ostream& os) {
+        ((os << "  " << Variants::NAME << ": " << Variants::DESCRIPTION << "\n"), ...);
+    }
+};
+
+typedef RulesList<StandardRules, NoStackingRules, PenaltyStackingRules, DrawUntilPlayableRules, ShortDeckRules>
+    RulesRegistry;
+
+#endif // RULES_H
@@ -0,0 +1,146 @@
+#ifndef TERMINALRENDERER_H
+#define TERMINALRENDERER_H
+
+#include "Card.h"
+#include "GameObserver.h"
+#include <cstdint>
+#include <iostream>
+
+/**
+ * @brief Observer that prints the game as text, as the original Game did.
+ *
+ * Lines end in '\n' rather than std::endl, so output stays in the stream
+ * buffer until it fills, the game ends, or std::cin (tied to std::cout)
+ * is read for a prompt. A fully automated run therefore does a handful
+ * of writes instead of one flush per line.
+ *
+ * Seats marked hidden (computer players sharing the terminal with
+ * people) never have their hand or the cards they draw printed.
+ *
+ * @author Tuan
+ */
+class TerminalRenderer {
+private:
+    std::ostream* out;
+    uint32_t hiddenSeats;   // bit s: do not show seat s's cards
+
+    bool hidden(int seat) const { return (hiddenSeats >> seat) & 1; }
+
+public:
+    explicit TerminalRenderer(std::ostream& stream = std::cout) : out(&stream), hiddenSeats(0) {}
+
+    void setStream(std::ostream& stream) { out = &stream; }
+
+    /** Keep seat's cards off the screen (or show them again). */
+    void setHidden(int seat, bool hide) {
+        if (hide) hiddenSeats |= 1u << seat;
+        else hiddenSeats &= ~(1u << seat);
+    }
+
+    template <typename Game>
+    void onGameStart(const Game& game) {
+        *out << "\nFirst card flipped: " << game.topCard() << '\n';
+    }
+
+    template <typename Game>
+    void onTurnStart(const Game& game, int seat) {
+        const auto& current = game.player(seat);
+        *out << "----------------------------------------\n";
+        *out << "Top card: " << game.topCard() << '\n';
+        *out << "Current player: " << game.playerName(seat)
+             << " (" << current.handSize() << " cards)\n";
+
+        *out << "Players: ";
+        for (int i = 0; i < game.playerCount(); i++) {
+            *out << game.playerName(i) << "(" << game.player(i).handSize() << ")";
+            if (i < game.playerCount() - 1) *out << "  ";
+        }
+        *out << '\n';
+        *out << "----------------------------------------\n";
+
+        if (hidden(seat)) return;
+        *out << "\n" << game.playerName(seat) << "'s hand:\n";
+        current.showHand(*out);
+    }
+
+    template <typename Game>
+    void onForcedDraw(const Game&, int) {
+        *out << "\nNo playable cards! Drawing from deck...\n";
+    }
+
+    template <typename Game>
+    void onCardDrawn(const Game&, int seat, Card card) {
+        if (hidden(seat)) *out << "Drew a card.\n";
+        else *out << "Drew: " << card << '\n';
+    }
+
+    template <typename Game>
+    void onDeckEmpty(const Game&, int) {
+        *out << "Deck is empty! Skipping turn.\n";
+    }
+
+    template <typename Game>
+    void onCardsPlayed(const Game& game, int seat, const Card* cards, int count) {
+        *out << game.playerName(seat) << " plays ";
+        for (int i = 0; i < count; i++) {
+            *out << cards[i];
+            if (i < count - 1) *out << " + ";
+        }
+        *out << '\n';
+    }
+
+    template <typename Game>
+    void onEffect(const Game& game, CardType type, int count, int target, int drawn) {
+        switch (type) {
+            case SKIP:
+                if (count == 1) {
+                    *out << ">> SKIP! Next player loses their turn.\n";
+                } else {
+                    *out << ">> SKIP x" << count
+                         << "! Next " << count << " players lose their turn.\n";
+                }
+                break;
+
+            case REVERSE:
+                if (count % 2 == 1) {
+                    *out << ">> REVERSE! Turn order reversed.\n";
+                } else {
+                    *out << ">> REVERSE x" << count
+                         << "! Direction unchanged (cancels out).\n";
+                }
+                break;
+
+            case DRAW_TWO:
+                if (count == 1) {
+                    *out << ">> DRAW TWO! " << game.playerName(target)
+                         << " draws " << drawn << " cards and loses their turn.\n";
+                } else {
+                    *out << ">> DRAW TWO x" << count << "! " << game.playerName(target)
+                         << " draws " << drawn << " cards and loses their turn.\n";
+                }
+                break;
+
+            case NUMBER:
+                break;
+        }
+    }
+
+    template <typename Game>
+    void onUno(const Game& game, int seat) {
+        *out << ">> " << game.playerName(seat) << " has UNO!\n";
+    }
+
+    template <typename Game>
+    void onWinner(const Game& game, int seat) {
+        *out << "\n========================================\n";
+        *out << "  " << game.playerName(seat) << " wins! Congratulations!\n";
+        *out << "========================================" << std::endl;
+    }
+
+    template <typename Game>
+    void onDraw(const Game&) {
+        *out << "\nTurn limit reached! The game is a draw." << std::endl;
+    }
+};
+
+#endif // TERMINALRENDERER_H
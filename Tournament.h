@@ -0,0 +1,270 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include "BotPolicies.h"
+#include "EndgameSolver.h"
+#include "GameEngine.h"
+#include "GameRecord.h"
+#include "GameStats.h"
+#include "MctsPolicy.h"
+#include "Random.h"
+#include "Rules.h"
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Totals collected over many games. Merging is a plain sum, so the
+ * result is the same whichever thread played which game. details holds
+ * the distributions (game length, cards drawn, stack sizes) in constant
+ * memory.
+ * @author Tuan
+ */
+struct TournamentStats {
+    std::vector<uint64_t> wins;   // wins per seat
+    uint64_t games;
+    uint64_t draws;               // games stopped by the turn limit
+    uint64_t totalTurns;
+    uint64_t checksum;            // order-independent hash of every result
+    GameStats details;
+
+    explicit TournamentStats(int seats = 0)
+        : wins(seats, 0), games(0), draws(0), totalTurns(0), checksum(0) {}
+
+    void record(uint64_t gameIndex, const GameResult& result) {
+        games++;
+        totalTurns += result.turns;
+        if (result.isDraw()) {
+            draws++;
+        } else {
+            wins[result.winner]++;
+        }
+        uint64_t h = gameIndex ^ (static_cast<uint64_t>(result.winner + 1) << 32)
+                   ^ static_cast<uint64_t>(result.turns);
+        checksum += splitmix64(h);
+    }
+
+    void merge(const TournamentStats& other) {
+        for (size_t i = 0; i < wins.size(); i++) wins[i] += other.wins[i];
+        games += other.games;
+        draws += other.draws;
+        totalTurns += other.totalTurns;
+        checksum += other.checksum;
+        details.merge(other.details);
+    }
+};
+
+/**
+ * Create a bot policy by name ("greedy", "random", "mcts" or "endgame");
+ * nullptr if unknown. "mcts" searches single-threaded with the default
+ * iteration budget, since the tournament already runs one game per core.
+ * "endgame" plays greedily until both hands of a two-player game hold at
+ * most 3 cards, then solves with the deck as it lies (an oracle that
+ * sees the cards to come, for measuring other bots against).
+ */
+inline std::unique_ptr<PlayerPolicy> makePolicy(const std::string& name) {
+    if (name == "greedy") return std::unique_ptr<PlayerPolicy>(new GreedyPolicy());
+    if (name == "random") return std::unique_ptr<PlayerPolicy>(new RandomPolicy());
+    if (name == "mcts") return std::unique_ptr<PlayerPolicy>(new MctsPolicy());
+    if (name == "endgame") return std::unique_ptr<PlayerPolicy>(new EndgamePolicy(3));
+    return nullptr;
+}
+
+/**
+ * Whether policy `name` plays correctly under Rules. "mcts" searches on
+ * its own standard-rules engine and "endgame" solves the standard rules,
+ * so any other rules refuse them (with a message), as they refuse records.
+ */
+template <typename Rules>
+inline bool policyFitsRules(const std::string& name) {
+    if (std::is_same<Rules, StandardRules>::value || (name != "mcts" && name != "endgame")) return true;
+    std::cerr << "Policy " << name << " plays the " << StandardRules::NAME << " rules only" << std::endl;
+    return false;
+}
+
+/**
+ * @brief Plays a batch of independent games on all cores.
+ *
+ * Game indices are split into one contiguous range per worker. A worker
+ * takes games from the front of its own range; when it runs dry it steals
+ * the back half of the largest other range. Each range is a single atomic
+ * word (begin in the low half, end in the high half), so claiming and
+ * stealing are one compare-and-swap each.
+ *
+ * Game i is always seeded with streamSeed(masterSeed, i), so the merged
+ * stats are bit-identical for any thread count.
+ *
+ * @tparam Rules House rules every game is played under (see Rules.h).
+ * @author Tuan
+ */
+template <typename Rules = StandardRules>
+class BasicTournament {
+private:
+    /** Per-thread state, on its own cache lines so workers never share one. */
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> range;
+        BasicGameEngine<StatsObserver, Rules> engine;
+        std::vector<std::unique_ptr<PlayerPolicy>> policies;
+        std::vector<std::unique_ptr<PlayerPolicy>> recorders;
+        std::vector<uint8_t> decisions;   // current game's decision stream
+        std::vector<uint8_t> pending;     // encoded records not yet written
+        std::vector<uint8_t> scratch;
+        TournamentStats stats;
+
+        Worker() : range(0) {}
+    };
+
+    static constexpr size_t RECORD_FLUSH_BYTES = 1 << 16;
+
+    std::vector<std::string> seatPolicies;
+    int maxTurns;
+    GameRecordWriter* recordWriter;
+    std::mutex recordLock;
+
+    void flushRecords(Worker& w) {
+        if (w.pending.empty()) return;
+        std::lock_guard<std::mutex> guard(recordLock);
+        recordWriter->append(w.pending);
+        w.pending.clear();
+    }
+
+    static uint64_t pack(uint32_t begin, uint32_t end) {
+        return (static_cast<uint64_t>(end) << 32) | begin;
+    }
+    static uint32_t rangeBegin(uint64_t r) { return static_cast<uint32_t>(r); }
+    static uint32_t rangeEnd(uint64_t r) { return static_cast<uint32_t>(r >> 32); }
+
+    /** Claim the next game from the front of a worker's own range. */
+    static bool claim(Worker& w, uint32_t& game) {
+        uint64_t r = w.range.load(std::memory_order_relaxed);
+        while (rangeBegin(r) < rangeEnd(r)) {
+            if (w.range.compare_exchange_weak(r, pack(rangeBegin(r) + 1, rangeEnd(r)),
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+                game = rangeBegin(r);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Steal the back half of the fullest other range into thief's range. */
+    static bool steal(Worker* workers, int numWorkers, int thief) {
+        while (true) {
+            int victim = -1;
+            uint64_t best = 0;
+            uint32_t bestSize = 0;
+            for (int i = 0; i < numWorkers; i++) {
+                if (i == thief) continue;
+                uint64_t r = workers[i].range.load(std::memory_order_relaxed);
+                uint32_t size = rangeEnd(r) - rangeBegin(r);
+                if (rangeBegin(r) < rangeEnd(r) && size > bestSize) {
+                    victim = i;
+                    best = r;
+                    bestSize = size;
+                }
+            }
+            if (victim < 0) return false;
+
+            uint32_t mid = rangeBegin(best) + bestSize / 2;
+            if (workers[victim].range.compare_exchange_strong(best, pack(rangeBegin(best), mid),
+                                                              std::memory_order_acq_rel,
+                                                              std::memory_order_relaxed)) {
+                workers[thief].range.store(pack(mid, rangeEnd(best)), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    void runWorker(Worker* workers, int numWorkers, int self, uint64_t masterSeed) {
+        Worker& w = workers[self];
+        uint32_t game;
+        while (true) {
+            while (claim(w, game)) {
+                uint64_t seed = streamSeed(masterSeed, game);
+                w.decisions.clear();
+                GameResult result = w.engine.runToCompletion(seed);
+                w.stats.record(game, result);
+                if (recordWriter != nullptr) {
+                    encodeGameRecord(w.pending, w.scratch, seed, w.engine.playerCount(), maxTurns,
+                                     result.winner, result.turns, w.decisions);
+                    if (w.pending.size() >= RECORD_FLUSH_BYTES) flushRecords(w);
+                }
+            }
+            if (!steal(workers, numWorkers, self)) break;
+        }
+        if (recordWriter != nullptr) flushRecords(w);
+    }
+
+public:
+    explicit BasicTournament(const std::vector<std::string>& seatPolicies,
+                             int maxTurns = GameEngine::DEFAULT_MAX_TURNS)
+        : seatPolicies(seatPolicies), maxTurns(maxTurns), recordWriter(nullptr) {}
+
+    /**
+     * Write a GameRecord of every game to writer (nullptr to stop).
+     * Records are appended in completion order, not game order. Records
+     * replay under the standard rules only, so other rules refuse them.
+     * Returns false if refused.
+     */
+    bool setRecordWriter(GameRecordWriter* writer) {
+        if (!std::is_same<Rules, StandardRules>::value && writer != nullptr) {
+            std::cerr << "setRecordWriter: records need the " << StandardRules::NAME << " rules" << std::endl;
+            return false;
+        }
+        recordWriter = writer;
+        return true;
+    }
+
+    /** Play `games` games from masterSeed on `threads` threads (0 = all cores). */
+    TournamentStats run(uint32_t games, uint64_t masterSeed, int threads = 0) {
+        if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+        if (threads <= 0) threads = 1;
+
+        std::unique_ptr<Worker[]> workers(new Worker[threads]);
+        int seats = static_cast<int>(seatPolicies.size());
+        for (int t = 0; t < threads; t++) {
+            Worker& w = workers[t];
+            w.stats = TournamentStats(seats);
+            w.engine.setMaxTurns(maxTurns);
+            for (int s = 0; s < seats; s++) {
+                w.policies.push_back(makePolicy(seatPolicies[s]));
+                PlayerPolicy* policy = w.policies.back().get();
+                if (recordWriter != nullptr) {
+                    w.recorders.push_back(std::unique_ptr<PlayerPolicy>(
+                        new RecordingPolicy(policy, &w.decisions)));
+                    policy = w.recorders.back().get();
+                }
+                w.engine.addPlayer(seatPolicies[s] + " " + std::to_string(s + 1), policy);
+            }
+            uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(games) * t / threads);
+            uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(games) * (t + 1) / threads);
+            w.range.store(pack(begin, end), std::memory_order_relaxed);
+        }
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) {
+            pool.emplace_back(&BasicTournament::runWorker, this, workers.get(), threads, t, masterSeed);
+        }
+        runWorker(workers.get(), threads, 0, masterSeed);
+        for (std::thread& th : pool) th.join();
+
+        TournamentStats total(seats);
+        for (int t = 0; t < threads; t++) {
+            workers[t].stats.details = workers[t].engine.getObserver().stats();
+            total.merge(workers[t].stats);
+        }
+        return total;
+    }
+};
+
+/** Tournament under the standard rules. */
+using Tournament = BasicTournament<StandardRules>;
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,304 @@
+#ifndef TRANSCRIPT_H
+#define TRANSCRIPT_H
+
+#include "GameEngine.h"
+#include "HumanPolicy.h"
+#include "PlayerPolicy.h"
+#include "TranscriptRecorder.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Text transcripts of terminal sessions, many games to a file.
+ *
+ * A transcript holds what people typed, so sessions can be replayed as
+ * regression tests without piping each one into a separate process:
+ *
+ *   game SEED PLAYERS
+ *   NAME                 (one line per player; empty for a computer player, as in Game)
+ *   INPUT                (one line per answer, in turn order, as at the prompts)
+ *   end WINNER TURNS     (winner's seat, -1 if the session stopped early)
+ *
+ * Input lines are whatever HumanPolicy read: "0,2" or "-1" at the card
+ * prompt, "y" or "n" after a forced draw, and any mistyped lines, which
+ * the replay rejects and skips just as the prompt did. No input line may
+ * start with "end ". Blank lines and lines starting with '#' between
+ * games are ignored. Games are played with no turn limit, as in Game.
+ *
+ * Every seat answers from the input lines, computer players included:
+ * their search is timed and spread over threads, so it cannot be run
+ * again to the same moves, and Game records what they chose instead
+ * (TranscriptRecorder). A replay therefore needs no computer policy.
+ *
+ * @author Tuan
+ */
+
+/** One game of a transcript, pointing into the mapped file. */
+struct TranscriptGame {
+    uint64_t seed;
+    int players;
+    int winner;
+    int turns;
+    long line;                       // line number of the "game" line (1-based)
+    const char* names[GameState::MAX_PLAYERS];
+    int nameLengths[GameState::MAX_PLAYERS];
+    const char* input;               // first input line
+    const char* inputEnd;            // start of the "end" line
+};
+
+/** Length of the line at p (not past end), without the newline. */
+inline size_t transcriptLineLength(const char* p, const char* end) {
+    const void* nl = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return nl ? static_cast<size_t>(static_cast<const char*>(nl) - p) : static_cast<size_t>(end - p);
+}
+
+/**
+ * Read an unsigned decimal field at p, skipping spaces before it.
+ * Returns false if there is none or it overflows.
+ */
+inline bool transcriptField(const char*& p, const char* end, uint64_t& value) {
+    while (p < end && *p == ' ') p++;
+    if (p == end || *p < '0' || *p > '9') return false;
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        uint64_t digit = static_cast<uint64_t>(*p++ - '0');
+        if (value > (UINT64_MAX - digit) / 10) return false;
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+/**
+ * @brief Memory-mapped sequential reader for a transcript file.
+ *
+ * The file is mapped read-only and parsed in place: names and input lines
+ * stay pointers into the mapping, and numbers are read without copies,
+ * locales or exceptions.
+ *
+ * @author Tuan
+ */
+class TranscriptReader {
+private:
+    const char* data;
+    size_t size;
+    const char* cursor;
+    long line;
+    bool malformed;
+
+    bool fail(const char* what) {
+        std::cerr << "TranscriptReader: line " << line << ": " << what << std::endl;
+        malformed = true;
+        cursor = data + size;
+        return false;
+    }
+
+    /** Advance past the current line. */
+    void nextLine(const char* end) {
+        cursor += transcriptLineLength(cursor, end);
+        if (cursor < end) cursor++;
+        line++;
+    }
+
+    static bool startsWith(const char* p, size_t length, const char* word) {
+        size_t n = std::strlen(word);
+        return length >= n && std::memcmp(p, word, n) == 0;
+    }
+
+public:
+    TranscriptReader() : data(nullptr), size(0), cursor(nullptr), line(1), malformed(false) {}
+    ~TranscriptReader() { close(); }
+
+    TranscriptReader(const TranscriptReader&) = delete;
+    TranscriptReader& operator=(const TranscriptReader&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "TranscriptReader: cannot open " << path << std::endl;
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            std::cerr << "TranscriptReader: " << path << " is empty" << std::endl;
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            std::cerr << "TranscriptReader: mmap failed for " << path << std::endl;
+            return false;
+        }
+        madvise(mapped, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+        data = static_cast<const char*>(mapped);
+        size = static_cast<size_t>(st.st_size);
+        rewind();
+        return true;
+    }
+
+    void rewind() {
+        cursor = data;
+        line = 1;
+        malformed = false;
+    }
+
+    /** True if reading stopped at a line that does not fit the format. */
+    bool failed() const { return malformed; }
+
+    /** Parse the next game into view. Returns false at the end or on a malformed game. */
+    bool next(TranscriptGame& view) {
+        if (cursor == nullptr) return false;
+        const char* end = data + size;
+
+        // Skip blank and comment lines up to the header
+        while (cursor < end) {
+            size_t length = transcriptLineLength(cursor, end);
+            if (length > 0 && cursor[length - 1] == '\r') length--;
+            if (length > 0 && cursor[0] != '#') break;
+            nextLine(end);
+        }
+        if (cursor >= end) return false;
+
+        size_t length = transcriptLineLength(cursor, end);
+        if (!startsWith(cursor, length, "game ")) return fail("expected \"game SEED PLAYERS\"");
+        const char* p = cursor + 5;
+        const char* lineEnd = cursor + length;
+        uint64_t seed, players;
+        if (!transcriptField(p, lineEnd, seed) || !transcriptField(p, lineEnd, players)) {
+            return fail("bad game header");
+        }
+        if (players < static_cast<uint64_t>(GameEngine::MIN_PLAYERS) ||
+            players > static_cast<uint64_t>(GameEngine::MAX_PLAYERS)) {
+            return fail("player count out of range");
+        }
+        view.seed = seed;
+        view.players = static_cast<int>(players);
+        view.line = line;
+        nextLine(end);
+
+        for (int i = 0; i < view.players; i++) {
+            if (cursor >= end) return fail("missing player names");
+            size_t n = transcriptLineLength(cursor, end);
+            if (n > 0 && cursor[n - 1] == '\r') n--;
+            view.names[i] = cursor;
+            view.nameLengths[i] = static_cast<int>(n);
+            nextLine(end);
+        }
+
+        view.input = cursor;
+        while (true) {
+            if (cursor >= end) return fail("missing \"end WINNER TURNS\"");
+            length = transcriptLineLength(cursor, end);
+            if (startsWith(cursor, length, "end ")) break;
+            nextLine(end);
+        }
+        view.inputEnd = cursor;
+
+        p = cursor + 4;
+        lineEnd = cursor + length;
+        bool noWinner = p < lineEnd && *p == '-';
+        if (noWinner) p++;
+        uint64_t winner, turns;
+        if (!transcriptField(p, lineEnd, winner) || !transcriptField(p, lineEnd, turns) ||
+            (noWinner && winner != 1) || turns > static_cast<uint64_t>(INT32_MAX) ||
+            (!noWinner && winner >= players)) {
+            return fail("bad \"end WINNER TURNS\" line");
+        }
+        view.winner = noWinner ? -1 : static_cast<int>(winner);
+        view.turns = static_cast<int>(turns);
+        nextLine(end);
+        return true;
+    }
+
+    void close() {
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), size);
+            data = nullptr;
+            size = 0;
+            cursor = nullptr;
+        }
+    }
+};
+
+/**
+ * @brief Policy that answers from the input lines of one transcript game.
+ *
+ * Every line goes through HumanPolicy's own parsing and
+ * GameEngine::isValidSelection: a line the prompt would have rejected is
+ * counted and skipped, and the next one is tried. One instance can serve
+ * every seat. If the lines run out it draws (or keeps the drawn card)
+ * and sets exhausted().
+ *
+ * @author Tuan
+ */
+class TranscriptPolicy : public PlayerPolicy {
+private:
+    const char* p;
+    const char* end;
+    uint64_t lines;
+    uint64_t rejected;
+    bool outOfInput;
+
+    /** Take the next input line, without its newline or '\r'. */
+    bool takeLine(const char*& begin, const char*& lineEnd) {
+        if (p >= end) {
+            outOfInput = true;
+            return false;
+        }
+        size_t length = transcriptLineLength(p, end);
+        begin = p;
+        lineEnd = p + length;
+        p = lineEnd < end ? lineEnd + 1 : end;
+        if (lineEnd > begin && lineEnd[-1] == '\r') lineEnd--;
+        lines++;
+        return true;
+    }
+
+public:
+    TranscriptPolicy() : p(nullptr), end(nullptr), lines(0), rejected(0), outOfInput(false) {}
+
+    /** Answer from game's input lines. Line and rejection counts carry over. */
+    void load(const TranscriptGame& game) {
+        p = game.input;
+        end = game.inputEnd;
+        outOfInput = false;
+    }
+
+    void chooseCards(const GameState& state, int seat, std::vector<int>& indices) override {
+        const char* begin;
+        const char* lineEnd;
+        while (takeLine(begin, lineEnd)) {
+            HumanPolicy::Answer answer = HumanPolicy::readSelection(begin, lineEnd, state, seat, indices, nullptr);
+            if (answer != HumanPolicy::ANSWER_INVALID) return;
+            rejected++;
+        }
+        indices.clear();
+    }
+
+    bool playDrawnCard(const GameState&, int, const Card&) override {
+        const char* begin;
+        const char* lineEnd;
+        if (!takeLine(begin, lineEnd)) return false;
+        return HumanPolicy::readYes(begin, lineEnd);
+    }
+
+    /** The game asked for more answers than its transcript has. */
+    bool exhausted() const { return outOfInput; }
+    /** Input lines of the current game not read yet. */
+    bool finished() const { return p >= end; }
+    uint64_t linesRead() const { return lines; }
+    uint64_t linesRejected() const { return rejected; }
+};
+
+#endif // TRANSCRIPT_H
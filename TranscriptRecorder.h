@@ -0,0 +1,86 @@
+#ifndef TRANSCRIPTRECORDER_H
+#define TRANSCRIPTRECORDER_H
+
+#include "GameEngine.h"
+#include "PlayerPolicy.h"
+#include "Random.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Wraps a policy and writes its decisions as transcript lines.
+ *
+ * Lines are what a person at HumanPolicy's prompts would type. With
+ * typoOdds > 0, one card prompt in typoOdds first gets a line the prompt
+ * rejects (not a number, or an index past the hand), so replays also
+ * cover re-prompting. A selection the engine would not accept is written
+ * as a draw, which is what the engine makes of it.
+ *
+ * The static writers produce the rest of the format described in
+ * Transcript.h. Writing needs no POSIX calls, unlike TranscriptReader, so
+ * the terminal game can record its sessions.
+ *
+ * @author Tuan
+ */
+class TranscriptRecorder : public PlayerPolicy {
+private:
+    PlayerPolicy* inner;
+    std::string* out;
+    Xoshiro256 rng;
+    uint32_t typoOdds;
+
+public:
+    TranscriptRecorder(PlayerPolicy* inner, std::string* out, uint32_t typoOdds = 0, uint64_t seed = 0)
+        : inner(inner), out(out), rng(seed), typoOdds(typoOdds) {}
+
+    /** Append the "game SEED PLAYERS" line and one line per name. */
+    static void writeHeader(std::string& text, uint64_t seed, const std::vector<std::string>& names) {
+        text += "game " + std::to_string(seed) + " " + std::to_string(names.size()) + "\n";
+        for (const std::string& name : names) text += name + "\n";
+    }
+
+    /**
+     * Append a line as it was typed. One that would read as the "end"
+     * line gets a space in front; both prompts reject it either way.
+     */
+    static void writeTyped(std::string& text, const std::string& line) {
+        if (line.compare(0, 4, "end ") == 0) text += ' ';
+        text += line;
+        text += '\n';
+    }
+
+    /** Append the "end WINNER TURNS" line. */
+    static void writeEnd(std::string& text, const GameResult& result) {
+        text += "end " + std::to_string(result.winner) + " " + std::to_string(result.turns) + "\n";
+    }
+
+    void newGame(uint64_t seed) override { inner->newGame(seed); }
+
+    void chooseCards(const GameState& state, int seat, std::vector<int>& indices) override {
+        inner->chooseCards(state, seat, indices);
+        const Player& player = state.players[seat];
+        if (typoOdds > 0 && rng.bounded(typoOdds) == 0) {
+            if (rng.bounded(2) == 0) *out += "x\n";
+            else *out += std::to_string(player.handSize()) + "\n";
+        }
+        if (indices.empty() || !GameEngine::isValidSelection(player, indices, state.topCard, nullptr)) {
+            *out += "-1\n";
+            indices.clear();
+            return;
+        }
+        for (size_t i = 0; i < indices.size(); i++) {
+            if (i > 0) *out += ',';
+            *out += std::to_string(indices[i]);
+        }
+        *out += '\n';
+    }
+
+    bool playDrawnCard(const GameState& state, int seat, const Card& drawn) override {
+        bool play = inner->playDrawnCard(state, seat, drawn);
+        *out += play ? "y\n" : "n\n";
+        return play;
+    }
+};
+
+#endif // TRANSCRIPTRECORDER_H
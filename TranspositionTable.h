@@ -0,0 +1,104 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+/**
+ * @brief Fixed-size hash table of 64-bit search results, shared by any
+ * number of threads without locks.
+ *
+ * Each slot keeps the data word and key ^ data, written and read with
+ * relaxed atomics. If two threads write one slot at the same time a
+ * reader may see half of each; the two words then do not XOR back to the
+ * key and the probe simply misses, so no lock is ever taken (Hyatt's
+ * lockless hashing).
+ *
+ * Slots come in buckets of two on one half cache line. The first slot
+ * keeps the entry with the highest priority, the top byte of the data
+ * word (e.g. the search depth); the second always takes the newest
+ * entry that lost to it. Nothing is ever resized or freed while in use.
+ *
+ * @author Khang
+ */
+class TranspositionTable {
+public:
+    static const int MAX_BITS = 30;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;   // key ^ data
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(32) Bucket {
+        Slot slots[2];
+    };
+
+    std::unique_ptr<Bucket[]> buckets;
+    uint64_t mask;
+
+    static int priority(uint64_t data) { return static_cast<int>(data >> 56); }
+
+public:
+    /** A table of 2^bits slots (16 bytes each). */
+    explicit TranspositionTable(int bits = 20) : mask(0) { resize(bits); }
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    /** Reallocate with 2^bits slots and clear. Not safe while other threads use the table. */
+    void resize(int bits) {
+        if (bits < 1 || bits > MAX_BITS) {
+            std::cerr << "resize: " << bits << " bits out of range (1-" << MAX_BITS << ")" << std::endl;
+            bits = 20;
+        }
+        size_t count = static_cast<size_t>(1) << (bits - 1);
+        buckets.reset(new Bucket[count]);
+        mask = count - 1;
+        clear();
+    }
+
+    /** Forget every entry. Not safe while other threads use the table. */
+    void clear() {
+        for (uint64_t b = 0; b <= mask; b++) {
+            for (Slot& slot : buckets[b].slots) {
+                slot.check.store(0, std::memory_order_relaxed);
+                slot.data.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Look up key. Returns false on a miss (or a slot torn by a concurrent write). */
+    bool probe(uint64_t key, uint64_t& data) const {
+        const Bucket& bucket = buckets[key & mask];
+        for (const Slot& slot : bucket.slots) {
+            uint64_t d = slot.data.load(std::memory_order_relaxed);
+            uint64_t c = slot.check.load(std::memory_order_relaxed);
+            if ((c ^ d) == key && d != 0) {
+                data = d;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Insert or replace the entry for key. */
+    void store(uint64_t key, uint64_t data) {
+        Bucket& bucket = buckets[key & mask];
+        Slot& first = bucket.slots[0];
+        uint64_t d = first.data.load(std::memory_order_relaxed);
+        uint64_t c = first.check.load(std::memory_order_relaxed);
+        Slot& target = ((c ^ d) == key || priority(data) >= priority(d)) ? first : bucket.slots[1];
+        target.data.store(data, std::memory_order_relaxed);
+        target.check.store(key ^ data, std::memory_order_relaxed);
+    }
+
+    size_t size() const { return static_cast<size_t>(mask + 1) * 2; }
+    size_t memoryBytes() const { return static_cast<size_t>(mask + 1) * sizeof(Bucket); }
+};
+
+#endif // TRANSPOSITIONTABLE_H
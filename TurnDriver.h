@@ -0,0 +1,195 @@
+#ifndef TURNDRIVER_H
+#define TURNDRIVER_H
+
+#if __cplusplus < 202002L
+#error "TurnDriver.h needs C++20 coroutines: compile with -std=c++20"
+#endif
+
+#include "GameEngine.h"
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A decision a game is waiting for, and the answer once given.
+ *
+ * Each running game owns one request and reuses it for every decision,
+ * so waiting allocates nothing. Whoever answers fills cards (or play)
+ * and calls resume().
+ *
+ * @author Tuan
+ */
+struct DecisionRequest {
+    int game;                  // caller-chosen id of the game
+    int seat;
+    TurnDecision kind;
+    Card drawn;                // DECIDE_PLAY_DRAWN: the card just drawn
+    const GameState* state;    // position to decide in
+    std::vector<int> cards;    // answer to DECIDE_CARDS (empty = draw)
+    bool play;                 // answer to DECIDE_PLAY_DRAWN
+    std::coroutine_handle<> waiter;
+
+    DecisionRequest()
+        : game(0), seat(-1), kind(DECIDE_NONE), state(nullptr), play(false) {}
+
+    /** Continue the waiting game until its next decision or its end. */
+    void resume() {
+        std::coroutine_handle<> h = waiter;
+        waiter = nullptr;
+        h.resume();
+    }
+};
+
+/**
+ * @brief Told about every decision a game waits for.
+ *
+ * requested() may answer at once and return true, and the game goes on
+ * without suspending. Otherwise it returns false and the game stays
+ * suspended until someone answers and calls request.resume(): a human
+ * prompt, a socket read or a search running elsewhere.
+ *
+ * @author Tuan
+ */
+class DecisionSink {
+public:
+    virtual ~DecisionSink() {}
+    virtual bool requested(DecisionRequest& request) = 0;
+};
+
+/**
+ * @brief Sink that queues every request, for one thread to answer in turn.
+ * @author Tuan
+ */
+class DecisionQueue : public DecisionSink {
+private:
+    std::deque<DecisionRequest*> waiting;
+
+public:
+    bool requested(DecisionRequest& request) override {
+        waiting.push_back(&request);
+        return false;
+    }
+
+    bool isEmpty() const { return waiting.empty(); }
+    size_t size() const { return waiting.size(); }
+
+    /** Oldest unanswered request, or null. */
+    DecisionRequest* next() {
+        if (waiting.empty()) return nullptr;
+        DecisionRequest* r = waiting.front();
+        waiting.pop_front();
+        return r;
+    }
+};
+
+/**
+ * @brief Handle to a game coroutine (see playGame).
+ *
+ * The coroutine starts suspended; start() runs it to its first decision.
+ * The frame is freed with the task. frameBytes() reports the size of the
+ * last frame allocated, to keep an eye on per-game memory.
+ *
+ * @author Tuan
+ */
+class GameTask {
+public:
+    struct promise_type {
+        inline static size_t lastFrameBytes = 0;
+
+        GameTask get_return_object() {
+            return GameTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        static void* operator new(size_t size) {
+            lastFrameBytes = size;
+            return ::operator new(size);
+        }
+        static void operator delete(void* frame, size_t size) { ::operator delete(frame, size); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit GameTask(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+public:
+    GameTask() : handle(nullptr) {}
+    GameTask(GameTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    GameTask& operator=(GameTask&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    ~GameTask() {
+        if (handle) handle.destroy();
+    }
+
+    GameTask(const GameTask&) = delete;
+    GameTask& operator=(const GameTask&) = delete;
+
+    /** Run the game up to its first decision (or to the end). */
+    void start() { handle.resume(); }
+
+    /** True once the game has finished. */
+    bool done() const { return !handle || handle.done(); }
+
+    static size_t frameBytes() { return promise_type::lastFrameBytes; }
+};
+
+/** Suspends the game until its request is answered (unless answered at once). */
+struct DecisionAwaiter {
+    DecisionRequest& request;
+    DecisionSink& sink;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> h) {
+        request.waiter = h;
+        if (!sink.requested(request)) return true;
+        request.waiter = nullptr;
+        return false;
+    }
+    void await_resume() const noexcept {}
+};
+
+/**
+ * Play the engine's current game to the end as a coroutine. Every seat
+ * decision is handed to sink through request and the game suspends until
+ * it is answered, so one thread can interleave any number of games. The
+ * engine, request and sink must outlive the task; the engine must already
+ * be started.
+ *
+ * Rules are the engine's own (beginTurn / answerCards / answerPlayDrawn),
+ * so a game gives the same result as engine.gameLoop() with the same
+ * answers.
+ */
+template <typename Observer, typename Rules>
+GameTask playGame(BasicGameEngine<Observer, Rules>& engine, DecisionRequest& request, DecisionSink& sink) {
+    while (!engine.isOver()) {
+        TurnDecision kind = engine.beginTurn();
+        if (kind == DECIDE_NONE) continue;
+
+        request.seat = engine.currentSeat();
+        request.kind = kind;
+        request.drawn = engine.drawnCard();
+        request.state = &engine.state();
+        co_await DecisionAwaiter{ request, sink };
+
+        if (kind == DECIDE_CARDS) {
+            engine.answerCards(request.cards);
+        } else {
+            engine.answerPlayDrawn(request.play);
+        }
+    }
+}
+
+#endif // TURNDRIVER_H
@@ -0,0 +1,229 @@
+#ifndef TURNRING_H
+#define TURNRING_H
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief Circular turn order over seat indices, doubly linked by index.
+ *
+ * Each seat stores the index of the seats before and after it, so moving
+ * in either direction, reversing and removing a seat are all O(1).
+ * skip(k) is O(1) while every seat is still in play (plain modular
+ * arithmetic) and O(k mod seats) after removals.
+ *
+ * Links are stored in fixed arrays of MAX_SEATS, so a ring is a small
+ * flat value that copies with memcpy.
+ *
+ * @author Khang
+ */
+class TurnRing {
+public:
+    static const int MAX_SEATS = 16;
+
+private:
+    int8_t nextSeat[MAX_SEATS];
+    int8_t prevSeat[MAX_SEATS];
+    int8_t seated[MAX_SEATS];
+    int8_t seats;
+    int8_t cur;
+    int8_t active;
+    bool forward;
+    bool contiguous;   // true until a seat is removed
+
+public:
+    TurnRing() : nextSeat(), prevSeat(), seated(), seats(0), cur(-1), active(0),
+                 forward(true), contiguous(true) {}
+
+    /** Seat 0..count-1 in order, moving forward from seat 0. */
+    void reset(int count) {
+        if (count < 0 || count > MAX_SEATS) {
+            std::cerr << "reset: " << count << " seats do not fit (max "
+                      << MAX_SEATS << ")" << std::endl;
+            count = 0;
+        }
+        seats = static_cast<int8_t>(count);
+        for (int i = 0; i < count; i++) {
+            nextSeat[i] = static_cast<int8_t>((i + 1 < count) ? i + 1 : 0);
+            prevSeat[i] = static_cast<int8_t>((i > 0) ? i - 1 : count - 1);
+            seated[i] = 1;
+        }
+        cur = static_cast<int8_t>((count > 0) ? 0 : -1);
+        active = static_cast<int8_t>(count);
+        forward = true;
+        contiguous = true;
+    }
+
+    int current() const { return cur; }
+    bool contains(int seat) const { return seated[seat] != 0; }
+    int size() const { return active; }
+    bool isEmpty() const { return active == 0; }
+    bool isForward() const { return forward; }
+
+    /** Seat that advance() would move to. */
+    int peekNext() const {
+        if (cur < 0) return -1;
+        return forward ? nextSeat[cur] : prevSeat[cur];
+    }
+
+    void advance() {
+        if (cur < 0) return;
+        cur = forward ? nextSeat[cur] : prevSeat[cur];
+    }
+
+    /** Advance k times. */
+    void skip(int k) {
+        if (cur < 0 || active <= 1) return;
+        k %= active;
+        if (contiguous) {
+            int step = forward ? k : active - k;
+            cur = static_cast<int8_t>((cur + step) % active);
+            return;
+        }
+        for (int i = 0; i < k; i++) advance();
+    }
+
+    void reverse() { forward = !forward; }
+
+    /**
+     * Take a seat out of the rotation. If it is the current seat, the
+     * current position moves back one step against the play direction, so
+     * the next advance() lands on the seat that would have played next.
+     */
+    void remove(int seat) {
+        if (seat < 0 || seat >= seats || !seated[seat]) {
+            std::cerr << "remove: seat " << seat << " is not in play" << std::endl;
+            return;
+        }
+        seated[seat] = 0;
+        active--;
+        contiguous = false;
+        if (active == 0) {
+            cur = -1;
+            return;
+        }
+        int8_t before = prevSeat[seat];
+        int8_t after = nextSeat[seat];
+        nextSeat[before] = after;
+        prevSeat[after] = before;
+        if (seat == cur) cur = forward ? before : after;
+    }
+};
+
+/**
+ * @brief TurnRing for tables of any size, with links sized at run time.
+ *
+ * Same moves and the same results as TurnRing for the same calls, but the
+ * links are 32-bit and live in vectors, so a ring of n seats costs about
+ * 9n bytes and holds millions of seats. advance(), reverse() and
+ * remove() are O(1). skip(k) is O(1) while every seat is in play and
+ * walks min(k, seats - k) links after removals, so its cost depends on
+ * the number of cards stacked, never on the size of the table.
+ *
+ * @author Khang
+ */
+class SeatRing {
+private:
+    std::vector<int32_t> nextSeat;
+    std::vector<int32_t> prevSeat;
+    std::vector<uint8_t> seated;
+    int32_t cur;
+    int32_t active;
+    bool forward;
+    bool contiguous;   // true until a seat is removed
+
+    void move(bool ahead) {
+        cur = (ahead == forward) ? nextSeat[cur] : prevSeat[cur];
+    }
+
+public:
+    SeatRing() : cur(-1), active(0), forward(true), contiguous(true) {}
+
+    /** Seat 0..count-1 in order, moving forward from seat 0. */
+    void reset(int count) {
+        if (count < 0) {
+            std::cerr << "reset: negative seat count " << count << std::endl;
+            count = 0;
+        }
+        nextSeat.resize(count);
+        prevSeat.resize(count);
+        seated.assign(count, 1);
+        for (int i = 0; i < count; i++) {
+            nextSeat[i] = (i + 1 < count) ? i + 1 : 0;
+            prevSeat[i] = (i > 0) ? i - 1 : count - 1;
+        }
+        cur = (count > 0) ? 0 : -1;
+        active = count;
+        forward = true;
+        contiguous = true;
+    }
+
+    int current() const { return cur; }
+    bool contains(int seat) const { return seated[seat] != 0; }
+    int size() const { return active; }
+    int capacity() const { return static_cast<int>(seated.size()); }
+    bool isEmpty() const { return active == 0; }
+    bool isForward() const { return forward; }
+
+    /** Seat that advance() would move to. */
+    int peekNext() const {
+        if (cur < 0) return -1;
+        return forward ? nextSeat[cur] : prevSeat[cur];
+    }
+
+    void advance() {
+        if (cur < 0) return;
+        move(true);
+    }
+
+    /** Advance k times. */
+    void skip(int k) {
+        if (cur < 0 || active <= 1) return;
+        k %= active;
+        if (contiguous) {
+            int step = forward ? k : active - k;
+            cur = static_cast<int32_t>((static_cast<int64_t>(cur) + step) % active);
+            return;
+        }
+        // Going k ahead is going active - k back; walk the shorter way
+        if (k <= active - k) {
+            for (int i = 0; i < k; i++) move(true);
+        } else {
+            for (int i = 0; i < active - k; i++) move(false);
+        }
+    }
+
+    void reverse() { forward = !forward; }
+
+    /**
+     * Take a seat out of the rotation. If it is the current seat, the
+     * current position moves back one step against the play direction, so
+     * the next advance() lands on the seat that would have played next.
+     */
+    void remove(int seat) {
+        if (seat < 0 || seat >= capacity() || !seated[seat]) {
+            std::cerr << "remove: seat " << seat << " is not in play" << std::endl;
+            return;
+        }
+        seated[seat] = 0;
+        active--;
+        contiguous = false;
+        if (active == 0) {
+            cur = -1;
+            return;
+        }
+        int32_t before = prevSeat[seat];
+        int32_t after = nextSeat[seat];
+        nextSeat[before] = after;
+        prevSeat[after] = before;
+        if (seat == cur) cur = forward ? before : after;
+    }
+
+    /** Heap bytes held by the links. */
+    size_t memoryBytes() const {
+        return nextSeat.capacity() * sizeof(int32_t) + prevSeat.capacity() * sizeof(int32_t) + seated.capacity();
+    }
+};
+
+#endif // TURNRING_H
@@ -0,0 +1,83 @@
+/**
+ * @file batch.cpp
+ * @brief Checks the lockstep BatchSimulator against the scalar engine and times both.
+ *
+ * Usage: batch [games] [players] [seed]
+ *   games    games to play (default 1000000)
+ *   players  greedy bots per game (default 4)
+ *   seed     master seed (default 1)
+ *
+ * Game i is seeded with streamSeed(seed, i) on both sides; every result
+ * must match. Build with -march=native to get the AVX2 / AVX-512 kernels.
+ *
+ * @author Tuan
+ */
+
+#include "BatchSimulator.h"
+#include "BotPolicies.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+template <int LANES>
+static bool runBatch(const std::vector<GameResult>& expected, int players, uint64_t seed, double scalarRate) {
+    std::unique_ptr<BatchSimulator<LANES>> sim(new BatchSimulator<LANES>(players));
+    uint64_t games = expected.size();
+    uint64_t mismatches = 0;
+    uint64_t firstBad = games;
+
+    Clock::time_point start = Clock::now();
+    sim->run(seed, 0, games, [&](uint64_t game, const GameResult& r) {
+        const GameResult& e = expected[game];
+        if (r.winner != e.winner || r.turns != e.turns) {
+            if (mismatches++ == 0 || game < firstBad) firstBad = game;
+        }
+    });
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    double rate = elapsed.count() > 0 ? games / elapsed.count() : 0.0;
+    std::cout << "Batch x" << LANES << ":    " << rate << " games/sec ("
+              << (scalarRate > 0 ? rate / scalarRate : 0.0) << "x scalar), ";
+    if (mismatches == 0) {
+        std::cout << "all results match" << std::endl;
+    } else {
+        std::cout << mismatches << " mismatches, first at game " << firstBad << std::endl;
+    }
+    return mismatches == 0;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t games = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int players = (argc > 2) ? std::atoi(argv[2]) : 4;
+    uint64_t seed = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 1;
+    if (players < GameEngine::MIN_PLAYERS || players > GameEngine::MAX_PLAYERS) {
+        std::cerr << "players must be " << GameEngine::MIN_PLAYERS << ".." << GameEngine::MAX_PLAYERS << std::endl;
+        return 1;
+    }
+
+    GameEngine engine;
+    std::vector<std::unique_ptr<GreedyPolicy>> bots;
+    for (int s = 0; s < players; s++) {
+        bots.emplace_back(new GreedyPolicy());
+        engine.addPlayer("Bot " + std::to_string(s + 1), bots.back().get());
+    }
+
+    std::vector<GameResult> expected(games);
+    Clock::time_point start = Clock::now();
+    for (uint64_t g = 0; g < games; g++) expected[g] = engine.runToCompletion(streamSeed(seed, g));
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    double scalarRate = elapsed.count() > 0 ? games / elapsed.count() : 0.0;
+
+    std::cout << "Kernel:       " << BatchSimulator<8>::kernelName() << "\n";
+    std::cout << "Scalar:       " << scalarRate << " games/sec" << std::endl;
+    bool ok = runBatch<8>(expected, players, seed, scalarRate);
+    ok = runBatch<16>(expected, players, seed, scalarRate) && ok;
+    ok = runBatch<32>(expected, players, seed, scalarRate) && ok;
+    return ok ? 0 : 2;
+}
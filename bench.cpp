@@ -0,0 +1,349 @@
+/**
+ * @file bench.cpp
+ * @brief Microbenchmarks for the data structures, the deck, hands, whole games
+ * and belief tracking.
+ *
+ * Usage: bench [--json] [--filter TEXT] [--min-time SEC]
+ *   --json      print one JSON document instead of a table
+ *   --filter    run only benchmarks whose name contains TEXT
+ *   --min-time  seconds per measurement (default 0.2)
+ *
+ * Each benchmark is scaled until one run takes --min-time, then measured
+ * five times; the reported ns/op is the median run. Allocations are counted
+ * by replacing the global operator new, so allocs/op counts every heap
+ * allocation the operation made.
+ *
+ * The JSON output keeps a fixed layout (one result per line, benchmarks in
+ * the order below) so files from two commits can be diffed directly.
+ *
+ * @author Tuan
+ */
+
+#include "BeliefTracker.h"
+#include "BotPolicies.h"
+#include "CircularLinkedList.h"
+#include "Deck.h"
+#include "GameEngine.h"
+#include "Player.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// --- Allocation counting ---
+
+static std::atomic<uint64_t> allocations(0);
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// --- Harness ---
+
+typedef std::chrono::steady_clock Clock;
+
+/** Keep value alive so the optimizer cannot drop the work that made it. */
+template <typename T>
+static inline void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations;
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+class Bench {
+private:
+    std::string filter;
+    double minTime;
+    std::vector<BenchResult> results;
+
+    template <typename Body>
+    static double timeRun(Body& body, uint64_t iterations, uint64_t& allocs) {
+        uint64_t before = allocations.load(std::memory_order_relaxed);
+        Clock::time_point start = Clock::now();
+        body(iterations);
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        allocs = allocations.load(std::memory_order_relaxed) - before;
+        return elapsed.count();
+    }
+
+public:
+    Bench(const std::string& filter, double minTime) : filter(filter), minTime(minTime) {}
+
+    /** body(n) must perform the operation n times. */
+    template <typename Body>
+    void run(const std::string& name, Body body) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+        uint64_t allocs = 0;
+        uint64_t iterations = 1;
+        double t = timeRun(body, iterations, allocs);
+        while (t < minTime && iterations < (1ULL << 40)) {
+            double grow = t > 0 ? 1.2 * minTime / t : 100.0;
+            iterations = static_cast<uint64_t>(iterations * std::min(100.0, std::max(2.0, grow)));
+            t = timeRun(body, iterations, allocs);
+        }
+
+        const int RUNS = 5;
+        double runs[RUNS];
+        uint64_t totalAllocs = 0;
+        for (int r = 0; r < RUNS; r++) {
+            runs[r] = timeRun(body, iterations, allocs);
+            totalAllocs += allocs;
+        }
+        std::sort(runs, runs + RUNS);
+
+        BenchResult result;
+        result.name = name;
+        result.iterations = iterations;
+        result.nsPerOp = runs[RUNS / 2] * 1e9 / iterations;
+        result.allocsPerOp = static_cast<double>(totalAllocs) / (static_cast<double>(iterations) * RUNS);
+        results.push_back(result);
+    }
+
+    void printTable(std::ostream& os) const {
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-36s %14s %12s %12s\n", "benchmark", "iterations", "ns/op", "allocs/op");
+        os << line;
+        for (const BenchResult& r : results) {
+            std::snprintf(line, sizeof(line), "%-36s %14llu %12.2f %12.3f\n", r.name.c_str(),
+                          static_cast<unsigned long long>(r.iterations), r.nsPerOp, r.allocsPerOp);
+            os << line;
+        }
+    }
+
+    void printJson(std::ostream& os) const {
+        char line[256];
+        os << "{\n  \"format\": 1,\n  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& r = results[i];
+            std::snprintf(line, sizeof(line),
+                          "    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f}%s\n",
+                          r.name.c_str(), static_cast<unsigned long long>(r.iterations), r.nsPerOp,
+                          r.allocsPerOp, i + 1 < results.size() ? "," : "");
+            os << line;
+        }
+        os << "  ]\n}" << std::endl;
+    }
+};
+
+// --- Benchmarks ---
+
+static void benchList(Bench& bench) {
+    const int N = 64;
+
+    bench.run("list/insertBack+removeFront", [](uint64_t n) {
+        CircularLinkedList<int> list;
+        for (int i = 0; i < N; i++) list.insertBack(i);
+        for (uint64_t i = 0; i < n; i++) {
+            list.insertBack(static_cast<int>(i));
+            list.removeFront();
+        }
+        keep(list.size());
+    });
+
+    bench.run("list/insertAt+removeAt/middle", [](uint64_t n) {
+        CircularLinkedList<int> list;
+        for (int i = 0; i < N; i++) list.insertBack(i);
+        for (uint64_t i = 0; i < n; i++) {
+            list.insertAt(N / 2, static_cast<int>(i));
+            list.removeAt(N / 2);
+        }
+        keep(list.size());
+    });
+
+    bench.run("list/get/64", [](uint64_t n) {
+        CircularLinkedList<int> list;
+        for (int i = 0; i < N; i++) list.insertBack(i);
+        int sum = 0;
+        for (uint64_t i = 0; i < n; i++) sum += list.get(static_cast<int>(i % N));
+        keep(sum);
+    });
+
+    const int SEATS[] = { 4, 10 };
+    for (int seats : SEATS) {
+        bench.run("list/advance/forward/" + std::to_string(seats), [seats](uint64_t n) {
+            CircularLinkedList<int> list;
+            for (int i = 0; i < seats; i++) list.insertBack(i);
+            for (uint64_t i = 0; i < n; i++) list.advance();
+            keep(list.getCurrent());
+        });
+        bench.run("list/advance/reversed/" + std::to_string(seats), [seats](uint64_t n) {
+            CircularLinkedList<int> list;
+            for (int i = 0; i < seats; i++) list.insertBack(i);
+            list.reverse();
+            for (uint64_t i = 0; i < n; i++) list.advance();
+            keep(list.getCurrent());
+        });
+    }
+}
+
+static void benchDeck(Bench& bench) {
+    bench.run("deck/build", [](uint64_t n) {
+        Deck deck;
+        for (uint64_t i = 0; i < n; i++) {
+            deck.build();
+            keep(deck.size());
+        }
+    });
+
+    bench.run("deck/build+shuffle", [](uint64_t n) {
+        Deck deck;
+        for (uint64_t i = 0; i < n; i++) {
+            deck.build();
+            deck.shuffle();
+            keep(deck.size());
+        }
+    });
+
+    bench.run("deck/build+shuffleAll", [](uint64_t n) {
+        Deck deck;
+        deck.seed(1);
+        for (uint64_t i = 0; i < n; i++) {
+            deck.build();
+            deck.shuffleAll();
+            keep(deck.size());
+        }
+    });
+
+    // Shuffled draw of all 100 cards; ns/op is per card
+    bench.run("deck/shuffle+drawFromDeck", [](uint64_t n) {
+        Deck deck;
+        deck.seed(1);
+        uint64_t done = 0;
+        int sum = 0;
+        while (done < n) {
+            deck.build();
+            deck.shuffle();
+            while (!deck.isEmpty() && done < n) {
+                sum += deck.drawFromDeck().kind();
+                done++;
+            }
+        }
+        keep(sum);
+    });
+}
+
+static void benchPlayer(Bench& bench) {
+    const int SIZES[] = { 1, 7, 20, 50 };
+    for (int size : SIZES) {
+        bench.run("player/hasPlayableCard/" + std::to_string(size), [size](uint64_t n) {
+            Deck deck;
+            deck.seed(static_cast<uint64_t>(size));
+            deck.build();
+            deck.shuffle();
+            Player player(0);
+            for (int i = 0; i < size; i++) player.drawCard(deck.drawFromDeck());
+
+            Card tops[Card::NUM_KINDS];
+            for (int k = 0; k < Card::NUM_KINDS; k++) tops[k] = Card::fromKind(k);
+            int playable = 0;
+            for (uint64_t i = 0; i < n; i++) {
+                playable += player.hasPlayableCard(tops[i % Card::NUM_KINDS]);
+            }
+            keep(playable);
+        });
+    }
+}
+
+static void benchGames(Bench& bench) {
+    const int SEATS[] = { 2, 4 };
+    for (int seats : SEATS) {
+        bench.run("game/greedy+random/" + std::to_string(seats), [seats](uint64_t n) {
+            GreedyPolicy greedy;
+            RandomPolicy random(1);
+            GameEngine engine;
+            for (int s = 0; s < seats; s++) {
+                engine.addPlayer("Bot " + std::to_string(s + 1),
+                                 s % 2 == 0 ? static_cast<PlayerPolicy*>(&greedy) : &random);
+            }
+            int turns = 0;
+            for (uint64_t i = 0; i < n; i++) turns += engine.runToCompletion(i + 1).turns;
+            keep(turns);
+        });
+    }
+}
+
+static void benchBeliefs(Bench& bench) {
+    // Same games as game/greedy+random/4, with a tracker following every event
+    bench.run("belief/game/4", [](uint64_t n) {
+        GreedyPolicy greedy;
+        RandomPolicy random(1);
+        BasicGameEngine<BeliefTracker> engine;
+        for (int s = 0; s < 4; s++) {
+            engine.addPlayer("Bot " + std::to_string(s + 1),
+                             s % 2 == 0 ? static_cast<PlayerPolicy*>(&greedy) : &random);
+        }
+        int turns = 0;
+        for (uint64_t i = 0; i < n; i++) turns += engine.runToCompletion(i + 1).turns;
+        keep(turns);
+    });
+
+    // One sampled deal for seat 0, forty turns into a game
+    bench.run("belief/determinize/4", [](uint64_t n) {
+        GreedyPolicy greedy;
+        BasicGameEngine<BeliefTracker> engine;
+        for (int s = 0; s < 4; s++) engine.addPlayer("Bot " + std::to_string(s + 1), &greedy);
+        engine.start(7);
+        for (int turn = 0; turn < 40 && !engine.isOver(); turn++) engine.step();
+
+        Xoshiro256 rng(1);
+        GameState world = engine.state();
+        int consistent = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            world = engine.state();
+            consistent += engine.getObserver().determinize(world, 0, rng);
+        }
+        keep(consistent);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    bool json = false;
+    std::string filter;
+    double minTime = 0.2;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: bench [--json] [--filter TEXT] [--min-time SEC]" << std::endl;
+            return 1;
+        }
+    }
+
+    Bench bench(filter, minTime);
+    benchList(bench);
+    benchDeck(bench);
+    benchPlayer(bench);
+    benchGames(bench);
+    benchBeliefs(bench);
+
+    if (json) {
+        bench.printJson(std::cout);
+    } else {
+        bench.printTable(std::cout);
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file client.cpp
+ * @brief Load-testing client for uno_server.
+ *
+ * Usage: uno_client [SOCKET] [games] [tables] [players] [connections]
+ *
+ *   SOCKET       server socket (default /tmp/uno-lite.sock)
+ *   games        games to play in total (default 10000)
+ *   tables       tables kept in play at once, over all connections (default 1000)
+ *   players      seats per table (default 4)
+ *   connections  client connections, one thread each (default 1)
+ *
+ * The client takes every seat at its tables and answers each prompt with
+ * the first legal play from MoveList. Move latency is the time from
+ * writing an answer to reading the table's next prompt or result.
+ *
+ * @author Tuan
+ */
+
+#include "MoveGen.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+typedef std::chrono::steady_clock Clock;
+
+static const int MAX_OPENING = 64;   // GameServer::MAX_OPEN_TABLES
+
+struct LoadStats {
+    uint64_t games;
+    uint64_t moves;
+    uint64_t errors;
+    std::vector<uint32_t> latencyNs;
+
+    LoadStats() : games(0), moves(0), errors(0) {}
+};
+
+static bool readNumber(const char*& p, long& value) {
+    while (*p == ' ' || *p == ',') p++;
+    char* end;
+    value = std::strtol(p, &end, 10);
+    if (end == p) return false;
+    p = end;
+    return true;
+}
+
+static bool writeAll(int fd, const std::string& data) {
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t n = ::send(fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static void runConnection(const std::string& path, uint64_t games, int inFlight, int players,
+                          uint64_t seedBase, LoadStats& stats) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::cerr << "Cannot connect to " << path << std::endl;
+        if (fd >= 0) ::close(fd);
+        return;
+    }
+
+    std::string in, out;
+    std::unordered_map<uint32_t, Clock::time_point> sentAt;
+    std::vector<uint32_t> answered;   // tables answered in the current batch
+    uint64_t started = 0;
+    int opening = 0;   // NEW sent, TABLE not yet read
+    MoveList moves;
+    std::vector<int> indices;
+    char line[128];
+
+    // Start tables until inFlight are in play, keeping under the server's
+    // limit of tables a connection may have waiting for players
+    auto topUp = [&]() {
+        while (started < games && started - stats.games < static_cast<uint64_t>(inFlight) &&
+               opening < MAX_OPENING) {
+            std::snprintf(line, sizeof(line), "NEW %d %llu\n", players,
+                          static_cast<unsigned long long>(seedBase + started));
+            out += line;
+            started++;
+            opening++;
+        }
+    };
+    topUp();
+
+    char buffer[1 << 16];
+    while (stats.games < games) {
+        if (!out.empty()) {
+            if (!writeAll(fd, out)) break;
+            out.clear();
+            Clock::time_point now = Clock::now();
+            for (uint32_t id : answered) sentAt[id] = now;
+            answered.clear();
+        }
+
+        ssize_t n = ::read(fd, buffer, sizeof(buffer));
+        if (n <= 0) break;
+        in.append(buffer, static_cast<size_t>(n));
+        Clock::time_point now = Clock::now();
+
+        size_t start = 0;
+        size_t newline;
+        while ((newline = in.find('\n', start)) != std::string::npos) {
+            in[newline] = '\0';
+            const char* p = in.c_str() + start;
+            start = newline + 1;
+
+            long id = 0;
+            const char* args = std::strchr(p, ' ');
+            if (args == nullptr || !readNumber(args, id)) continue;
+            uint32_t table = static_cast<uint32_t>(id);
+
+            if (std::strncmp(p, "TURN", 4) == 0 || std::strncmp(p, "DRAWN", 5) == 0 ||
+                std::strncmp(p, "OVER", 4) == 0) {
+                auto it = sentAt.find(table);
+                if (it != sentAt.end()) {
+                    stats.latencyNs.push_back(static_cast<uint32_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(now - it->second).count()));
+                }
+            }
+
+            if (std::strncmp(p, "TABLE", 5) == 0) {
+                for (int s = 0; s < players; s++) {
+                    std::snprintf(line, sizeof(line), "SIT %u Bot %d\n", table, s + 1);
+                    out += line;
+                }
+                opening--;
+                topUp();
+            } else if (std::strncmp(p, "TURN", 4) == 0) {
+                long seat, top, kind;
+                readNumber(args, seat);
+                readNumber(args, top);
+                Hand hand;
+                while (readNumber(args, kind)) hand.add(Card::fromKind(static_cast<int>(kind)));
+
+                moves.generate(hand, Card::fromKind(static_cast<int>(top)));
+                moves[0].toIndices(hand, indices);
+                int len = std::snprintf(line, sizeof(line), "%s %u", indices.empty() ? "DRAW" : "PLAY", table);
+                for (size_t i = 0; i < indices.size(); i++) {
+                    len += std::snprintf(line + len, sizeof(line) - len, "%c%d", i ? ',' : ' ', indices[i]);
+                }
+                out.append(line, static_cast<size_t>(len));
+                out += '\n';
+                answered.push_back(table);
+                stats.moves++;
+            } else if (std::strncmp(p, "DRAWN", 5) == 0) {
+                std::snprintf(line, sizeof(line), "YES %u\n", table);
+                out += line;
+                answered.push_back(table);
+                stats.moves++;
+            } else if (std::strncmp(p, "OVER", 4) == 0 || std::strncmp(p, "ABORT", 5) == 0) {
+                if (p[0] == 'A') stats.errors++;
+                sentAt.erase(table);
+                stats.games++;
+                topUp();
+            } else if (std::strncmp(p, "ERROR", 5) == 0) {
+                if (stats.errors++ < 5) std::cerr << p << std::endl;
+            }
+        }
+        in.erase(0, start);
+    }
+    ::close(fd);
+}
+
+static double percentile(std::vector<uint32_t>& v, double q) {
+    if (v.empty()) return 0.0;
+    size_t k = static_cast<size_t>(q * (v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k] / 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+    std::string path = (argc > 1) ? argv[1] : "/tmp/uno-lite.sock";
+    uint64_t games = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10000;
+    int tables = (argc > 3) ? std::atoi(argv[3]) : 1000;
+    int players = (argc > 4) ? std::atoi(argv[4]) : 4;
+    int connections = (argc > 5) ? std::atoi(argv[5]) : 1;
+    if (connections < 1) connections = 1;
+    if (tables < connections) tables = connections;
+
+    std::vector<LoadStats> stats(connections);
+    std::vector<std::thread> threads;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < connections; i++) {
+        uint64_t share = games / connections + (static_cast<uint64_t>(i) < games % connections ? 1 : 0);
+        threads.emplace_back(runConnection, path, share, tables / connections, players,
+                             static_cast<uint64_t>(i) << 32, std::ref(stats[i]));
+    }
+    for (std::thread& t : threads) t.join();
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    LoadStats total;
+    for (LoadStats& s : stats) {
+        total.games += s.games;
+        total.moves += s.moves;
+        total.errors += s.errors;
+        total.latencyNs.insert(total.latencyNs.end(), s.latencyNs.begin(), s.latencyNs.end());
+    }
+
+    std::cout << "Games:      " << total.games << "\n";
+    std::cout << "Moves:      " << total.moves << "\n";
+    std::cout << "Errors:     " << total.errors << "\n";
+    std::cout << "Moves/sec:  " << (elapsed.count() > 0 ? total.moves / elapsed.count() : 0.0) << "\n";
+    std::cout << "Latency us: p50 " << percentile(total.latencyNs, 0.50)
+              << "  p99 " << percentile(total.latencyNs, 0.99)
+              << "  max " << percentile(total.latencyNs, 1.0) << std::endl;
+    return total.errors == 0 ? 0 : 2;
+}
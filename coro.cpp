@@ -0,0 +1,142 @@
+/**
+ * @file coro.cpp
+ * @brief Interleaves many games on one thread with the coroutine turn driver.
+ *
+ * Usage: coro [games] [tables] [players] [seed]
+ *   games    games to play in total (default 100000)
+ *   tables   games kept suspended at once (default 5000)
+ *   players  seats per game (default 4)
+ *   seed     master seed (default 1)
+ *
+ * Every seat is a greedy bot, answered from a DecisionQueue in arrival
+ * order. The same games are then played again with engine.gameLoop(); the
+ * results must match. Prints the coroutine frame size, the cost of one
+ * bare suspend/queue/resume round and the cost per decision over the
+ * direct loop.
+ *
+ * @author Tuan
+ */
+
+#include "BotPolicies.h"
+#include "TurnDriver.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+struct Table {
+    GameEngine engine;
+    DecisionRequest request;
+    GameTask task;
+};
+
+static uint64_t mix(uint64_t h, const GameResult& r) {
+    h ^= static_cast<uint64_t>(r.winner + 1) * 0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(r.turns);
+    return h * 0x100000001B3ULL;
+}
+
+static GameTask bounce(DecisionRequest& request, DecisionSink& sink, uint64_t rounds) {
+    for (uint64_t i = 0; i < rounds; i++) co_await DecisionAwaiter{ request, sink };
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t games = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    int tables = (argc > 2) ? std::atoi(argv[2]) : 5000;
+    int players = (argc > 3) ? std::atoi(argv[3]) : 4;
+    uint64_t seed = (argc > 4) ? std::strtoull(argv[4], nullptr, 10) : 1;
+    if (tables < 1) tables = 1;
+    if (players < 2 || players > GameState::MAX_PLAYERS) {
+        std::cerr << "players must be 2.." << GameState::MAX_PLAYERS << std::endl;
+        return 1;
+    }
+
+    GreedyPolicy bot;
+    DecisionQueue queue;
+
+    // --- Coroutines: every game suspended on its decision at once ---
+    std::vector<std::unique_ptr<Table>> slots;
+    std::vector<GameResult> results(games);
+    std::vector<int64_t> gameOf(tables, -1);
+    uint64_t started = 0, finished = 0, decisions = 0;
+    size_t gameFrameBytes = 0;   // read before bounce() allocates a frame of its own
+
+    auto startGame = [&](int slot) {
+        Table& t = *slots[slot];
+        t.engine.start(seed + started);
+        t.request.game = slot;
+        t.task = playGame(t.engine, t.request, queue);
+        if (gameFrameBytes == 0) gameFrameBytes = GameTask::frameBytes();
+        gameOf[slot] = static_cast<int64_t>(started++);
+        t.task.start();
+    };
+
+    Clock::time_point begin = Clock::now();
+    for (int i = 0; i < tables; i++) {
+        slots.emplace_back(new Table());
+        for (int s = 0; s < players; s++) slots[i]->engine.addPlayer("Bot " + std::to_string(s + 1), nullptr);
+        if (started < games) startGame(i);
+    }
+
+    while (DecisionRequest* r = queue.next()) {
+        if (r->kind == DECIDE_CARDS) {
+            bot.chooseCards(*r->state, r->seat, r->cards);
+        } else {
+            r->play = bot.playDrawnCard(*r->state, r->seat, r->drawn);
+        }
+        decisions++;
+        r->resume();
+
+        Table& t = *slots[r->game];
+        if (t.task.done()) {
+            results[gameOf[r->game]] = t.engine.result();
+            finished++;
+            if (started < games) startGame(r->game);
+        }
+    }
+    std::chrono::duration<double> coroTime = Clock::now() - begin;
+
+    // --- Direct loop: the same games, one at a time ---
+    GameEngine direct;
+    std::vector<std::unique_ptr<GreedyPolicy>> bots;
+    for (int s = 0; s < players; s++) {
+        bots.emplace_back(new GreedyPolicy());
+        direct.addPlayer("Bot " + std::to_string(s + 1), bots.back().get());
+    }
+
+    uint64_t coroSum = 0, directSum = 0, mismatches = 0;
+    begin = Clock::now();
+    for (uint64_t g = 0; g < games; g++) {
+        GameResult r = direct.runToCompletion(seed + g);
+        directSum = mix(directSum, r);
+        coroSum = mix(coroSum, results[g]);
+        if (r.winner != results[g].winner || r.turns != results[g].turns) mismatches++;
+    }
+    std::chrono::duration<double> directTime = Clock::now() - begin;
+
+    // --- Bare suspension: a loop that only awaits ---
+    const uint64_t ROUNDS = 10000000;
+    DecisionRequest ping;
+    GameTask pinger = bounce(ping, queue, ROUNDS);
+    begin = Clock::now();
+    pinger.start();
+    while (DecisionRequest* r = queue.next()) r->resume();
+    std::chrono::duration<double> bounceTime = Clock::now() - begin;
+
+    double perDecision = decisions ? (coroTime.count() - directTime.count()) * 1e9 / decisions : 0.0;
+    std::cout << "Games:            " << finished << " (" << tables << " in flight)\n";
+    std::cout << "Decisions:        " << decisions << "\n";
+    std::cout << "Coroutine time:   " << coroTime.count() << " s\n";
+    std::cout << "Direct time:      " << directTime.count() << " s\n";
+    std::cout << "Frame bytes:      " << sizeof(GameTask) << " handle + "
+              << gameFrameBytes << " frame\n";
+    std::cout << "Suspend+resume:   " << bounceTime.count() * 1e9 / ROUNDS << " ns bare, "
+              << perDecision << " ns per decision over direct\n";
+    std::cout << "Checksum:         " << std::hex << coroSum << " / " << directSum << std::dec
+              << (mismatches ? "  MISMATCH" : "  match") << std::endl;
+    return mismatches == 0 ? 0 : 2;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file endgame.cpp
+ * @brief Solves two-player endgames exactly and rates bots against them.
+ *
+ * Usage: endgame [--threads N] [--expected SAMPLES] [positions] [cards] [nodes] [seed]
+ *   --threads   solver threads sharing one table (default 1)
+ *   --expected  also rate bots by expected regret over SAMPLES reshuffles
+ *               of the draw pile (default 0 = off)
+ *   positions   endgames to solve (default 200)
+ *   cards       largest hand in an endgame (default 3)
+ *   nodes       node budget per solve (default 2000000)
+ *   seed        master seed (default 1)
+ *
+ * Positions come from greedy-against-random games: the first decision in
+ * each game where both hands hold at most `cards` cards. Every move of
+ * each one is solved with the deck as it lies (double dummy). The solver
+ * line says how many roots were proven and how fast; then each bot is
+ * asked for its move and scored where the solver decided it:
+ *   blunders  the bot's move loses although a winning move exists
+ *   found     the bot's move wins, of the positions with a winning move
+ *   regret    best expected winning chance minus the bot's (--expected)
+ *
+ * @author Tuan
+ */
+
+#include "BotPolicies.h"
+#include "EndgameSolver.h"
+#include "GameEngine.h"
+#include "MctsPolicy.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+/** A bot under test and its scores. */
+struct Rated {
+    std::string name;
+    std::unique_ptr<PlayerPolicy> policy;
+    uint64_t winnable;   // positions with a winning move and the bot's move decided
+    uint64_t found;
+    uint64_t blunders;
+    double regret;
+    uint64_t regretPositions;
+
+    Rated(const std::string& name, PlayerPolicy* policy)
+        : name(name), policy(policy), winnable(0), found(0), blunders(0), regret(0.0), regretPositions(0) {}
+};
+
+/** Play greedy against random and keep the first endgame of each game. */
+static std::vector<GameState> collect(int positions, int cards, uint64_t seed) {
+    GreedyPolicy greedy;
+    RandomPolicy random;
+    GameEngine engine;
+    engine.addPlayer("Greedy", &greedy);
+    engine.addPlayer("Random", &random);
+    std::vector<GameState> found;
+    std::vector<int> indices;
+    for (uint64_t g = 0; static_cast<int>(found.size()) < positions && g < 100ULL * positions + 1000; g++) {
+        engine.start(streamSeed(seed, g));
+        while (!engine.isOver()) {
+            TurnDecision decision = engine.beginTurn();
+            const GameState& state = engine.state();
+            int seat = state.order.current();
+            if (decision == DECIDE_PLAY_DRAWN) {
+                engine.answerPlayDrawn(true);
+                continue;
+            }
+            if (decision != DECIDE_CARDS) continue;
+            if (state.players[0].handSize() <= cards && state.players[1].handSize() <= cards) {
+                found.push_back(state);
+                break;
+            }
+            PlayerPolicy& policy = seat == 0 ? static_cast<PlayerPolicy&>(greedy) : random;
+            policy.chooseCards(state, seat, indices);
+            engine.answerCards(indices);
+        }
+    }
+    return found;
+}
+
+/** Index in moves of what policy plays in state; an invalid selection draws, as in the engine. */
+static int askMove(PlayerPolicy& policy, const GameState& state, const MoveList& moves) {
+    int seat = state.order.current();
+    std::vector<int> indices;
+    policy.chooseCards(state, seat, indices);
+    Play play = Play();
+    if (GameEngine::isValidSelection(state.players[seat], indices, state.topCard, nullptr)) {
+        play = Play::fromIndices(state.players[seat].hand, indices);
+    }
+    return moves.find(play);
+}
+
+int main(int argc, char* argv[]) {
+    int threads = 1;
+    int samples = 0;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--expected" && i + 1 < argc) {
+            samples = std::atoi(argv[++i]);
+        } else {
+            args.push_back(arg);
+        }
+    }
+    int positions = args.size() > 0 ? std::atoi(args[0].c_str()) : 200;
+    int cards = args.size() > 1 ? std::atoi(args[1].c_str()) : 3;
+    uint64_t nodes = args.size() > 2 ? std::strtoull(args[2].c_str(), nullptr, 10) : 2000000;
+    uint64_t seed = args.size() > 3 ? std::strtoull(args[3].c_str(), nullptr, 10) : 1;
+    if (positions < 1 || cards < 1 || threads < 1) {
+        std::cerr << "positions, cards and threads must be at least 1" << std::endl;
+        return 1;
+    }
+
+    EndgameConfig config;
+    config.maxNodes = nodes;
+    config.threads = threads;
+    EndgameSolver solver(config);
+
+    std::vector<GameState> states = collect(positions, cards, seed);
+    std::cout << "Endgames: " << states.size() << " with both hands at most " << cards << " cards, "
+              << nodes << " nodes per solve, " << threads << " thread(s), "
+              << solver.tableBytes() / (1024 * 1024) << " MiB table" << std::endl;
+
+    std::vector<Rated> bots;
+    bots.emplace_back("greedy", new GreedyPolicy());
+    bots.emplace_back("random", new RandomPolicy(seed));
+    MctsConfig mcts;
+    mcts.iterations = 500;
+    bots.emplace_back("mcts", new MctsPolicy(mcts, seed));
+
+    uint64_t proven = 0, decided = 0, moveCount = 0, totalNodes = 0;
+    std::chrono::duration<double> solving(0);
+    std::vector<int> values;
+    std::vector<double> chances;
+    for (size_t p = 0; p < states.size(); p++) {
+        const GameState& state = states[p];
+        EndgamePosition position;
+        if (!position.load(state)) continue;
+        MoveList moves;
+        moves.generate(state.players[state.order.current()].hand, state.topCard);
+
+        Clock::time_point start = Clock::now();
+        EndgameResult result = solver.analyze(position, values);
+        solving += Clock::now() - start;
+        totalNodes += result.nodes;
+        if (result.proven()) proven++;
+        bool winnable = false;
+        for (int v : values) {
+            moveCount++;
+            if (v != EndgameResult::UNKNOWN) decided++;
+            if (v == EndgameResult::WIN) winnable = true;
+        }
+
+        double best = 0.0;
+        if (samples > 0 && moves.size() > 1) best = solver.expected(position, samples, streamSeed(seed, p), chances);
+        for (Rated& bot : bots) {
+            bot.policy->newGame(streamSeed(seed, p));
+            int m = askMove(*bot.policy, state, moves);
+            if (m < 0 || m >= static_cast<int>(values.size())) continue;
+            if (winnable && values[m] != EndgameResult::UNKNOWN) {
+                bot.winnable++;
+                if (values[m] == EndgameResult::WIN) bot.found++;
+                if (values[m] == EndgameResult::LOSS) bot.blunders++;
+            }
+            if (samples > 0 && m < static_cast<int>(chances.size())) {
+                bot.regret += best - chances[m];
+                bot.regretPositions++;
+            }
+        }
+    }
+
+    double secs = solving.count();
+    size_t n = states.size();
+    std::cout << "Solver: " << proven << "/" << n << " roots proven, " << decided << "/" << moveCount
+              << " moves decided, " << (n ? secs * 1e3 / n : 0.0) << " ms/position, "
+              << (secs > 0 ? totalNodes / secs / 1e6 : 0.0) << " M nodes/s" << std::endl;
+    for (const Rated& bot : bots) {
+        std::cout << "  " << bot.name << ": " << bot.blunders << " blunders, found " << bot.found << "/"
+                  << bot.winnable << " wins";
+        if (bot.winnable > 0) std::cout << " (" << 100.0 * bot.found / bot.winnable << "%)";
+        if (bot.regretPositions > 0) {
+            std::cout << ", expected regret " << bot.regret / bot.regretPositions;
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
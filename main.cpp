@@ -1,18 +1,37 @@
 /**
  * @file main.cpp
  * @brief Entry point for UNO-Lite.
+ *
+ * Usage: uno [--seed N] [--transcript FILE]
+ *   --seed        deal from seed N (default: the current time); the game
+ *                 prints its seed, so a session can be dealt again
+ *   --transcript  append the session to FILE for `transcript` to replay
+ *
  * @author Tuan
  */
 
 #include "Game.h"
 #include <cstdlib>
 #include <ctime>
+#include <iostream>
+#include <string>
 
-int main() {
-    srand(static_cast<unsigned>(time(nullptr)));
-
+int main(int argc, char* argv[]) {
     Game game;
-    game.setupGame();
+    uint64_t seed = static_cast<uint64_t>(time(nullptr));
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--transcript" && i + 1 < argc) {
+            if (!game.recordTo(argv[++i])) return 1;
+        } else {
+            std::cerr << "Usage: uno [--seed N] [--transcript FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    game.setupGame(seed);
     game.gameLoop();
 
     return 0;
@@ -0,0 +1,131 @@
+/**
+ * @file massive.cpp
+ * @brief Plays greedy bots at tables of thousands of seats (LargeTable).
+ *
+ * Usage: massive [--watch TURNS] [--places N] [seats] [games] [decks] [seed]
+ *   --watch  print the first TURNS turns of one game and stop
+ *   --places end each game once N seats are out (default 1, 0 = play to the last seat)
+ *   seats    seats at the table (default 10000)
+ *   games    games to play (default 10)
+ *   decks    standard decks, 0 = enough for the table (default 0)
+ *   seed     master seed (default 1)
+ *
+ * First checks small tables against GameEngine with GreedyPolicy, then
+ * reports turns per second and memory, and the cost per turn at 10 to
+ * 100,000 seats so it can be seen not to grow with the table.
+ *
+ * @author Tuan
+ */
+
+#include "BotPolicies.h"
+#include "GameEngine.h"
+#include "LargeTable.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+/** Same seeds at up to ten seats and one deck must give GameEngine's results. */
+static bool checkAgainstEngine(int players, uint64_t seed, uint64_t games) {
+    GameEngine engine;
+    std::vector<std::unique_ptr<GreedyPolicy>> bots;
+    for (int s = 0; s < players; s++) {
+        bots.emplace_back(new GreedyPolicy());
+        engine.addPlayer("Bot " + std::to_string(s + 1), bots.back().get());
+    }
+    std::unique_ptr<LargeTable<>> table(new LargeTable<>(players, 1));
+    table->setMaxTurns(GameEngine::DEFAULT_MAX_TURNS);
+    uint64_t mismatches = 0;
+    for (uint64_t g = 0; g < games; g++) {
+        GameResult e = engine.runToCompletion(streamSeed(seed, g));
+        GameResult r = table->runToCompletion(streamSeed(seed, g));
+        if (e.winner != r.winner || e.turns != r.turns) mismatches++;
+    }
+    std::cout << "Check " << players << " seats: " << games << " games, ";
+    if (mismatches == 0) {
+        std::cout << "all match GameEngine" << std::endl;
+    } else {
+        std::cout << mismatches << " mismatches" << std::endl;
+    }
+    return mismatches == 0;
+}
+
+/**
+ * Play games at the given size and print one line. Dealing is O(seats)
+ * and is timed apart from the turns. Returns nanoseconds per turn.
+ */
+static double play(int seats, int decks, int places, uint64_t games, uint64_t seed) {
+    std::unique_ptr<LargeTable<>> table(new LargeTable<>(seats, decks));
+    table->setPlaces(places);
+    uint64_t turns = 0;
+    uint64_t out = 0;
+    std::chrono::duration<double> dealing(0), playing(0);
+    for (uint64_t g = 0; g < games; g++) {
+        Clock::time_point start = Clock::now();
+        table->start(streamSeed(seed, g));
+        Clock::time_point dealt = Clock::now();
+        table->gameLoop();
+        playing += Clock::now() - dealt;
+        dealing += dealt - start;
+        turns += table->turns();
+        out += table->finishers().size();
+    }
+    double ns = turns ? playing.count() * 1e9 / turns : 0.0;
+    std::cout << "  " << seats << " seats, " << table->deckCount() << " decks: " << games << " games, "
+              << (games ? turns / games : 0) << " turns and " << (games ? out / games : 0) << " out per game, "
+              << ns << " ns/turn, " << (games ? dealing.count() * 1e3 / games : 0.0) << " ms/deal, "
+              << table->memoryBytes() / 1024 << " KiB (" << table->memoryBytes() / seats << " B/seat)" << std::endl;
+    return ns;
+}
+
+int main(int argc, char* argv[]) {
+    int watch = 0;
+    int places = 1;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--watch" && i + 1 < argc) {
+            watch = std::atoi(argv[++i]);
+        } else if (arg == "--places" && i + 1 < argc) {
+            places = std::atoi(argv[++i]);
+        } else {
+            args.push_back(arg);
+        }
+    }
+    int seats = args.size() > 0 ? std::atoi(args[0].c_str()) : 10000;
+    uint64_t games = args.size() > 1 ? std::strtoull(args[1].c_str(), nullptr, 10) : 10;
+    int decks = args.size() > 2 ? std::atoi(args[2].c_str()) : 0;
+    uint64_t seed = args.size() > 3 ? std::strtoull(args[3].c_str(), nullptr, 10) : 1;
+    if (seats < LargeTable<>::MIN_PLAYERS) {
+        std::cerr << "Need at least " << LargeTable<>::MIN_PLAYERS << " seats." << std::endl;
+        return 1;
+    }
+
+    if (watch > 0) {
+        std::unique_ptr<LargeTable<LargeTableRenderer>> table(new LargeTable<LargeTableRenderer>(seats, decks));
+        table->setPlaces(places);
+        table->start(seed);
+        for (int t = 0; t < watch && table->step(); t++) {}
+        std::cout.flush();
+        return 0;
+    }
+
+    bool ok = checkAgainstEngine(2, seed, 20000);
+    ok = checkAgainstEngine(4, seed, 20000) && ok;
+    ok = checkAgainstEngine(GameState::MAX_PLAYERS, seed, 20000) && ok;
+
+    std::cout << "Table:" << std::endl;
+    play(seats, decks, places, games, seed);
+
+    std::cout << "Scaling (played until half the seats are out):" << std::endl;
+    const int SIZES[] = { 10, 100, 1000, 10000, 100000 };
+    for (int n : SIZES) {
+        play(n, 0, n / 2, 100000 / n + 1, seed);
+    }
+    return ok ? 0 : 2;
+}
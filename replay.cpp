@@ -0,0 +1,103 @@
+/**
+ * @file replay.cpp
+ * @brief Replays recorded games through the real engine.
+ *
+ * Usage: replay FILE         re-run every record and check each outcome
+ *        replay FILE INDEX   print record INDEX (0-based) turn by turn
+ *
+ * @author Tuan
+ */
+
+#include "GameEngine.h"
+#include "GameRecord.h"
+#include "TerminalRenderer.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+/** Seat `players` players that all answer from one ReplayPolicy. */
+template <typename Engine>
+static void seatReplayPlayers(Engine& engine, int players, ReplayPolicy* replay) {
+    for (int i = 0; i < players; i++) {
+        engine.addPlayer("Player " + std::to_string(i + 1), replay);
+    }
+}
+
+static int printGame(GameRecordReader& reader, long index) {
+    GameRecordView view;
+    for (long i = 0; i <= index; i++) {
+        if (!reader.next(view)) {
+            std::cerr << "No record " << index << std::endl;
+            return 1;
+        }
+    }
+
+    ReplayPolicy replay;
+    replay.load(view.decisions, view.decisionBytes);
+    BasicGameEngine<TerminalRenderer> engine;
+    seatReplayPlayers(engine, view.players, &replay);
+    engine.setMaxTurns(view.maxTurns);
+    std::cout << "Seed " << view.seed << ", " << view.players << " players" << std::endl;
+    GameResult result = engine.runToCompletion(view.seed);
+
+    bool ok = !replay.failed() && replay.finished() &&
+              result.winner == view.winner && result.turns == view.turns;
+    std::cout << (ok ? "Replay matches the record." : "Replay DIVERGES from the record.") << std::endl;
+    return ok ? 0 : 2;
+}
+
+static int verifyAll(GameRecordReader& reader) {
+    ReplayPolicy replay;
+    std::unique_ptr<GameEngine> engine;
+    int seated = 0;
+    uint64_t records = 0, diverged = 0, turns = 0, bytes = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    GameRecordView view;
+    while (reader.next(view)) {
+        if (!engine || seated != view.players) {
+            engine.reset(new GameEngine());
+            seatReplayPlayers(*engine, view.players, &replay);
+            seated = view.players;
+        }
+        replay.load(view.decisions, view.decisionBytes);
+        engine->setMaxTurns(view.maxTurns);
+        GameResult result = engine->runToCompletion(view.seed);
+
+        if (replay.failed() || !replay.finished() ||
+            result.winner != view.winner || result.turns != view.turns) {
+            if (diverged < 10) {
+                std::cout << "Record " << records << " (seed " << view.seed << ") diverges: "
+                          << "winner " << result.winner << " vs " << view.winner
+                          << ", turns " << result.turns << " vs " << view.turns << std::endl;
+            }
+            diverged++;
+        }
+        records++;
+        turns += view.turns;
+        bytes += view.decisionBytes;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Records:    " << records << "\n";
+    std::cout << "Diverged:   " << diverged << "\n";
+    std::cout << "Bytes/turn: " << (turns ? static_cast<double>(bytes) / turns : 0.0) << "\n";
+    std::cout << "Games/sec:  " << (elapsed.count() > 0 ? records / elapsed.count() : 0.0)
+              << std::endl;
+    if (reader.failed()) return 1;
+    return diverged == 0 ? 0 : 2;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: replay FILE [INDEX]" << std::endl;
+        return 1;
+    }
+    GameRecordReader reader;
+    if (!reader.open(argv[1])) return 1;
+
+    if (argc > 2) return printGame(reader, std::atol(argv[2]));
+    return verifyAll(reader);
+}
@@ -0,0 +1,45 @@
+/**
+ * @file server.cpp
+ * @brief Multi-table UNO-Lite server on a Unix domain socket.
+ *
+ * Usage: uno_server [SOCKET]   (default /tmp/uno-lite.sock)
+ *
+ * Runs until SIGINT or SIGTERM, then prints what it served. The protocol
+ * is described in GameServer.h.
+ *
+ * @author Tuan
+ */
+
+#include "GameServer.h"
+#include <csignal>
+#include <iostream>
+#include <string>
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void requestStop(int) { stopRequested = 1; }
+
+int main(int argc, char* argv[]) {
+    std::string path = (argc > 1) ? argv[1] : "/tmp/uno-lite.sock";
+
+    GameServer server;
+    if (!server.listen(path)) return 1;
+
+    struct sigaction action;
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = 0;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    std::cout << "Listening on " << path << " (" << GameServer::tableBytes()
+              << " bytes per table)" << std::endl;
+    server.run(stopRequested);
+
+    std::cout << "Games:       " << server.games() << "\n";
+    std::cout << "Moves:       " << server.moves() << "\n";
+    std::cout << "Peak tables: " << server.peakTableCount() << "\n";
+    std::cout << "Left open:   " << server.tableCount() << std::endl;
+    ::unlink(path.c_str());
+    return 0;
+}
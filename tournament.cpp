@@ -0,0 +1,119 @@
+/**
+ * @file tournament.cpp
+ * @brief Runs many bot-vs-bot games in parallel and prints the totals.
+ *
+ * Usage: tournament [--rules NAME] [--record FILE] [--stats] [games] [threads] [seed] [policy...]
+ *   --rules  house rules to play (default standard); "--rules list" lists them
+ *   --record append a GameRecord of every game to FILE (see replay.cpp);
+ *            standard rules only
+ *   --stats  print turn counters and latency histograms at the end
+ *            (needs a build with -DUNO_INSTRUMENT, see Instrument.h)
+ *   games    number of games to play (default 100000)
+ *   threads  worker threads, 0 = all cores (default 0)
+ *   seed     master seed (default 1)
+ *   policy   one per seat: greedy | random | mcts | endgame (default: greedy random);
+ *            mcts and endgame play the standard rules only
+ *
+ * @author Tuan
+ */
+
+#include "Instrument.h"
+#include "Rules.h"
+#include "Tournament.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/** Play the tournament under Rules and print the report; returns the exit code. */
+template <typename Rules>
+static int runTournament(const std::vector<std::string>& seats, uint32_t games, int threads, uint64_t seed,
+                         const std::string& recordPath, bool printStats) {
+    typedef BasicGameEngine<NullObserver, Rules> Engine;
+    if (static_cast<int>(seats.size()) < Engine::MIN_PLAYERS ||
+        static_cast<int>(seats.size()) > Engine::MAX_PLAYERS) {
+        std::cerr << "Need between " << Engine::MIN_PLAYERS << " and "
+                  << Engine::MAX_PLAYERS << " seats." << std::endl;
+        return 1;
+    }
+    for (const std::string& s : seats) {
+        if (!policyFitsRules<Rules>(s)) return 1;
+    }
+
+    BasicTournament<Rules> tournament(seats);
+    GameRecordWriter writer;
+    if (!recordPath.empty()) {
+        if (!tournament.setRecordWriter(&writer) || !writer.open(recordPath)) return 1;
+    }
+    auto start = std::chrono::steady_clock::now();
+    TournamentStats stats = tournament.run(games, seed, threads);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Rules:      " << Rules::NAME << "\n";
+    std::cout << "Games:      " << stats.games << "\n";
+    for (size_t i = 0; i < seats.size(); i++) {
+        std::cout << "Seat " << (i + 1) << " (" << seats[i] << "): " << stats.wins[i] << " wins\n";
+    }
+    std::cout << "Draws:      " << stats.draws << "\n";
+    std::cout << "Avg turns:  "
+              << (stats.games ? static_cast<double>(stats.totalTurns) / stats.games : 0.0) << "\n";
+    std::cout << "Checksum:   " << std::hex << stats.checksum << std::dec << "\n";
+    std::cout << "Games/sec:  " << (elapsed.count() > 0 ? stats.games / elapsed.count() : 0.0)
+              << std::endl;
+
+    std::vector<std::string> seatNames;
+    for (size_t i = 0; i < seats.size(); i++) seatNames.push_back("Seat " + std::to_string(i + 1) + " (" + seats[i] + ")");
+    stats.details.print(std::cout, seatNames);
+    if (printStats) Instrument::print(std::cout);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::string rulesName = StandardRules::NAME;
+    std::string recordPath;
+    bool printStats = false;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--rules" && i + 1 < argc) {
+            rulesName = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--stats") {
+            printStats = true;
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (rulesName == "list") {
+        std::cout << "Rules:\n";
+        RulesRegistry::list(std::cout);
+        return 0;
+    }
+
+    uint32_t games = args.size() > 0 ? static_cast<uint32_t>(std::strtoul(args[0].c_str(), nullptr, 10)) : 100000;
+    int threads = args.size() > 1 ? std::atoi(args[1].c_str()) : 0;
+    uint64_t seed = args.size() > 2 ? std::strtoull(args[2].c_str(), nullptr, 10) : 1;
+
+    std::vector<std::string> seats;
+    for (size_t i = 3; i < args.size(); i++) seats.push_back(args[i]);
+    if (seats.empty()) seats = { "greedy", "random" };
+
+    for (const std::string& s : seats) {
+        if (!makePolicy(s)) {
+            std::cerr << "Unknown policy: " << s << std::endl;
+            return 1;
+        }
+    }
+
+    int status = 1;
+    bool found = RulesRegistry::visit(rulesName, [&](auto tag) {
+        status = runTournament<typename decltype(tag)::type>(seats, games, threads, seed, recordPath, printStats);
+    });
+    if (!found) {
+        std::cerr << "Unknown rules: " << rulesName << " (try --rules list)" << std::endl;
+        return 1;
+    }
+    return status;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file transcript.cpp
+ * @brief Replays typed game transcripts through the real engine.
+ *
+ * Usage: transcript FILE                         replay every game and check its outcome
+ *        transcript --write FILE GAMES [SEED]    write GAMES bot games as a transcript
+ *
+ * Replaying maps the file and feeds each game's lines, in one process,
+ * to the same parsing and validation the terminal prompts use (see
+ * Transcript.h). A game diverges if it ends with another winner or after
+ * another number of turns, asks for more lines than it has, or leaves
+ * lines unread. Every seat, a computer player's too, answers from the
+ * lines, so the names only label the seats. --write plays greedy and
+ * random bots at 2 to 4 seats and types an invalid line at about one card
+ * prompt in 8, for tests and for timing. `uno --transcript FILE` records
+ * real sessions.
+ *
+ * @author Tuan
+ */
+
+#include "BotPolicies.h"
+#include "GameEngine.h"
+#include "Transcript.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+static int writeGames(const std::string& path, uint64_t games, uint64_t seed) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "Cannot open " << path << " for writing" << std::endl;
+        return 1;
+    }
+    const int TYPO_ODDS = 8;
+    std::string text;
+    std::vector<std::unique_ptr<PlayerPolicy>> bots;
+    std::vector<std::unique_ptr<TranscriptRecorder>> recorders;
+    std::unique_ptr<GameEngine> engines[GameEngine::MAX_PLAYERS + 1];
+    std::vector<std::string> names[GameEngine::MAX_PLAYERS + 1];
+    for (int players = 2; players <= 4; players++) {
+        engines[players].reset(new GameEngine());
+        for (int s = 0; s < players; s++) {
+            bots.emplace_back(s % 2 == 0 ? static_cast<PlayerPolicy*>(new GreedyPolicy()) : new RandomPolicy());
+            recorders.emplace_back(new TranscriptRecorder(bots.back().get(), &text, TYPO_ODDS,
+                                                          streamSeed(seed, 100 * players + s)));
+            names[players].push_back(s % 2 == 0 ? "Greedy" : "Random");
+            engines[players]->addPlayer(names[players].back(), recorders.back().get());
+        }
+    }
+
+    uint64_t bytes = 0;
+    for (uint64_t g = 0; g < games; g++) {
+        int players = 2 + static_cast<int>(g % 3);
+        uint64_t gameSeed = streamSeed(seed, g);
+        text.clear();
+        TranscriptRecorder::writeHeader(text, gameSeed, names[players]);
+        GameResult result = engines[players]->runToCompletion(gameSeed);
+        TranscriptRecorder::writeEnd(text, result);
+        std::fwrite(text.data(), 1, text.size(), file);
+        bytes += text.size();
+    }
+    std::fclose(file);
+    std::cout << "Wrote " << games << " games (" << bytes / 1024 << " KiB) to " << path << std::endl;
+    return 0;
+}
+
+static int replayAll(TranscriptReader& reader) {
+    TranscriptPolicy policy;
+    std::unique_ptr<GameEngine> engine;
+    int seated = 0;
+    uint64_t games = 0, diverged = 0, turns = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    TranscriptGame view;
+    while (reader.next(view)) {
+        if (!engine || seated != view.players) {
+            engine.reset(new GameEngine());
+            for (int s = 0; s < view.players; s++) engine->addPlayer("Player " + std::to_string(s + 1), &policy);
+            seated = view.players;
+        }
+        policy.load(view);
+        // Games have no turn limit; stopping at the recorded count only cuts off a diverging one
+        engine->setMaxTurns(view.turns > 0 ? view.turns : 1);
+        GameResult result = engine->runToCompletion(view.seed);
+
+        if (policy.exhausted() || !policy.finished() ||
+            result.winner != view.winner || result.turns != view.turns) {
+            if (diverged < 10) {
+                std::cout << "Game at line " << view.line << " (seed " << view.seed << ") diverges: "
+                          << "winner " << result.winner << " vs " << view.winner
+                          << ", turns " << result.turns << " vs " << view.turns;
+                if (policy.exhausted()) std::cout << ", ran out of input";
+                if (!policy.finished()) std::cout << ", input left over";
+                std::cout << std::endl;
+            }
+            diverged++;
+        }
+        games++;
+        turns += static_cast<uint64_t>(result.turns);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double secs = elapsed.count();
+
+    std::cout << "Games:      " << games << "\n";
+    std::cout << "Diverged:   " << diverged << "\n";
+    std::cout << "Lines:      " << policy.linesRead() << " (" << policy.linesRejected() << " rejected)\n";
+    std::cout << "Turns:      " << turns << "\n";
+    std::cout << "Lines/sec:  " << (secs > 0 ? policy.linesRead() / secs : 0.0) << "\n";
+    std::cout << "Games/sec:  " << (secs > 0 ? games / secs : 0.0) << std::endl;
+    if (reader.failed()) return 1;
+    return diverged == 0 ? 0 : 2;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 3 && std::string(argv[1]) == "--write") {
+        uint64_t games = std::strtoull(argv[3], nullptr, 10);
+        uint64_t seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1;
+        return writeGames(argv[2], games, seed);
+    }
+    if (argc < 2) {
+        std::cerr << "Usage: transcript FILE | transcript --write FILE GAMES [SEED]" << std::endl;
+        return 1;
+    }
+    TranscriptReader reader;
+    if (!reader.open(argv[1])) return 1;
+    return replayAll(reader);
+}